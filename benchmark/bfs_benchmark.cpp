@@ -0,0 +1,84 @@
+#include "gdwg/algorithm.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+// Breadth-first search of a graph<int, int> with 16 random out-edges per node, on 1 to 32
+// threads: the whole search with bfs, reachable between random pairs, and a single-threaded
+// queue over connections_view for comparison. Scaling needs as many cores as threads.
+
+namespace {
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, int> const& {
+		static auto graphs = std::map<std::int64_t, gdwg::graph<int, int>>{};
+		auto& g = graphs[n];
+		if (g.empty()) {
+			auto engine = std::mt19937{6771};
+			auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+			auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+			for (auto from = 0; from < n; ++from) {
+				for (auto i = 0; i < 16; ++i) {
+					edges.emplace_back(from, node(engine), 1);
+				}
+			}
+			g = gdwg::graph<int, int>(edges.begin(), edges.end());
+		}
+		return g;
+	}
+
+	void bfs(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		auto const threads = static_cast<std::size_t>(state.range(1));
+		for (auto _ : state) {
+			auto tree = gdwg::bfs(g, 0, threads);
+			benchmark::DoNotOptimize(tree.hops(1));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 16);
+	}
+
+	void reachable(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto const& g = make_graph(n);
+		auto const threads = static_cast<std::size_t>(state.range(1));
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::reachable(g, node(engine), node(engine), threads));
+		}
+	}
+
+	void queue(benchmark::State& state) {
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto const& g = make_graph(state.range(0));
+		for (auto _ : state) {
+			auto hops = std::vector<std::uint32_t>(n, std::numeric_limits<std::uint32_t>::max());
+			auto queue = std::vector<int>{0};
+			hops[0] = 0;
+			for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+				auto const from = queue[i];
+				for (auto const to : g.connections_view(from)) {
+					auto& h = hops[static_cast<std::size_t>(to)];
+					if (h == std::numeric_limits<std::uint32_t>::max()) {
+						h = hops[static_cast<std::size_t>(from)] + 1;
+						queue.push_back(to);
+					}
+				}
+			}
+			benchmark::DoNotOptimize(hops.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 16);
+	}
+} // namespace
+
+BENCHMARK(bfs)
+   ->ArgsProduct({{100'000, 1'000'000}, benchmark::CreateRange(1, 32, 2)})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+BENCHMARK(reachable)
+   ->ArgsProduct({{100'000, 1'000'000}, benchmark::CreateRange(1, 32, 2)})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+BENCHMARK(queue)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
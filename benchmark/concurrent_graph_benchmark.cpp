@@ -0,0 +1,104 @@
+#include "gdwg/concurrent_graph.hpp"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// is_connected throughput from 1 to 32 reader threads, against a graph<int, int> behind one mutex,
+// with and without a thread changing the graph at the same time.
+
+template<>
+inline constexpr auto gdwg::copy_mode_for<int, int> = gdwg::copy_mode::copy_on_write;
+
+namespace {
+	constexpr auto node_count = 100'000;
+
+	// node_count nodes with 8 random out-edges each.
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto from = 0; from < node_count; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), 0);
+			}
+		}
+		return gdwg::graph<int, int>(edges.begin(), edges.end());
+	}
+
+	struct locked_graph {
+		auto is_connected(int const src, int const dst) -> bool {
+			auto const lock = std::scoped_lock{mutex};
+			return g.is_connected(src, dst);
+		}
+		auto insert_edge(int const src, int const dst, int const weight) -> bool {
+			auto const lock = std::scoped_lock{mutex};
+			return g.insert_edge(src, dst, weight);
+		}
+
+		std::mutex mutex;
+		gdwg::graph<int, int> g = make_graph();
+	};
+
+	template<typename G>
+	auto shared_graph() -> G& {
+		static auto g = G(make_graph());
+		return g;
+	}
+	template<>
+	auto shared_graph<locked_graph>() -> locked_graph& {
+		static auto g = locked_graph{};
+		return g;
+	}
+
+	// Inserts random edges until stopped.
+	template<typename G>
+	class writer {
+	public:
+		explicit writer(G& g)
+		: thread_{[this, &g] {
+			auto engine = std::mt19937{2};
+			auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+			auto weight = 1;
+			while (!stop_.load()) {
+				g.insert_edge(node(engine), node(engine), weight++);
+			}
+		}} {}
+		writer(writer const&) = delete;
+		auto operator=(writer const&) -> writer& = delete;
+		~writer() {
+			stop_ = true;
+			thread_.join();
+		}
+
+	private:
+		std::atomic<bool> stop_{false};
+		std::thread thread_;
+	};
+
+	template<typename G, bool Writing>
+	void is_connected(benchmark::State& state) {
+		auto& g = shared_graph<G>();
+		auto background = std::unique_ptr<writer<G>>{};
+		if (Writing && state.thread_index() == 0) {
+			background = std::make_unique<writer<G>>(g);
+		}
+		auto engine = std::mt19937{static_cast<std::mt19937::result_type>(state.thread_index())};
+		auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(node(engine), node(engine)));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	using concurrent = gdwg::concurrent_graph<int, int>;
+} // namespace
+
+BENCHMARK_TEMPLATE(is_connected, locked_graph, false)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(is_connected, concurrent, false)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(is_connected, locked_graph, true)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(is_connected, concurrent, true)->ThreadRange(1, 32)->UseRealTime();
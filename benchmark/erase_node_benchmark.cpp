@@ -0,0 +1,223 @@
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+	// Same values as int, but without the reverse edge index.
+	enum class outgoing_weight : int {};
+} // namespace
+
+template<>
+inline constexpr auto gdwg::edge_index_for<int, outgoing_weight> = gdwg::edge_index::outgoing;
+
+namespace {
+	// n nodes with 8 random out-edges each.
+	template<typename E>
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, E> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto edges = std::vector<typename gdwg::graph<int, E>::value_type>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), E{weight(engine)});
+			}
+		}
+		return gdwg::graph<int, E>(edges.begin(), edges.end());
+	}
+
+	// Erases nodes in random order, rebuilding (untimed) once half of them are gone.
+	template<typename E>
+	void erase_node(benchmark::State& state) {
+		auto const n = state.range(0);
+		auto engine = std::mt19937{1};
+		auto order = std::vector<int>(static_cast<std::size_t>(n));
+		auto g = gdwg::graph<int, E>{};
+		auto next = order.size() / 2;
+		for (auto _ : state) {
+			if (next == order.size() / 2) {
+				state.PauseTiming();
+				g = make_graph<E>(n);
+				std::iota(order.begin(), order.end(), 0);
+				std::shuffle(order.begin(), order.end(), engine);
+				next = 0;
+				state.ResumeTiming();
+			}
+			benchmark::DoNotOptimize(g.erase_node(order[next++]));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// A hub, node 0, with an edge to and from each of degree / 2 other nodes.
+	template<typename E>
+	auto make_hub(std::int64_t const degree) -> gdwg::graph<int, E> {
+		auto edges = std::vector<typename gdwg::graph<int, E>::value_type>{};
+		for (auto i = 1; i <= degree / 2; ++i) {
+			edges.emplace_back(0, i, E{i % 100});
+			edges.emplace_back(i, 0, E{i % 100});
+		}
+		return gdwg::graph<int, E>(edges.begin(), edges.end());
+	}
+
+	// Runs change on a fresh copy of original each iteration; copying is untimed.
+	template<typename E, typename F>
+	void change_copies(benchmark::State& state, gdwg::graph<int, E> const& original, F change) {
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = original;
+			state.ResumeTiming();
+			change(g);
+			state.PauseTiming();
+			g.clear();
+			state.ResumeTiming();
+		}
+	}
+
+	template<typename E, typename F>
+	void erase_from_hub(benchmark::State& state, F erase) {
+		change_copies(state, make_hub<E>(state.range(0)), erase);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename E>
+	void erase_hub_node(benchmark::State& state) {
+		erase_from_hub<E>(state, [](auto& g) { benchmark::DoNotOptimize(g.erase_node(0)); });
+	}
+
+	template<typename E>
+	void erase_hub_nodes(benchmark::State& state) {
+		erase_from_hub<E>(state, [](auto& g) {
+			auto const hub = std::vector<int>{0};
+			benchmark::DoNotOptimize(g.erase_nodes(hub.begin(), hub.end()));
+		});
+	}
+
+	template<typename E>
+	void erase_hub_edges(benchmark::State& state) {
+		erase_from_hub<E>(state, [](auto& g) { benchmark::DoNotOptimize(g.erase_edges(0)); });
+	}
+
+	template<typename E>
+	void erase_hub_edges_if(benchmark::State& state) {
+		erase_from_hub<E>(state, [](auto& g) {
+			benchmark::DoNotOptimize(
+			   g.erase_edges_if([](auto const& e) { return e.from == 0 || e.to == 0; }));
+		});
+	}
+
+	// The hub's out-edges one erase_edge at a time, for comparison with erase_edges.
+	template<typename E>
+	void erase_hub_edges_one_by_one(benchmark::State& state) {
+		erase_from_hub<E>(state, [](auto& g) {
+			for (auto it = g.begin(); it != g.end() && (*it).from == 0;) {
+				it = g.erase_edge(it);
+			}
+		});
+	}
+
+	// Two hubs, nodes 0 and 1, each with edges to and from degree / 2 random nodes of degree, so
+	// some of their edges coincide once merged.
+	auto make_hubs(std::int64_t const degree) -> gdwg::graph<int, int> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(2, static_cast<int>(degree) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 3);
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto hub = 0; hub < 2; ++hub) {
+			for (auto i = 0; i < degree / 2; ++i) {
+				edges.emplace_back(hub, node(engine), weight(engine));
+				edges.emplace_back(node(engine), hub, weight(engine));
+			}
+		}
+		return gdwg::graph<int, int>(edges.begin(), edges.end());
+	}
+
+	void merge_hubs(benchmark::State& state) {
+		change_copies(state, make_hubs(state.range(0)), [](auto& g) { g.merge_replace_node(0, 1); });
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// The same merge as merge_hubs by copying out the edges of node 0, inserting them one by one
+	// under node 1 and erasing node 0.
+	void merge_hubs_by_reinserting(benchmark::State& state) {
+		change_copies(state, make_hubs(state.range(0)), [](auto& g) {
+			auto moved = std::vector<gdwg::graph<int, int>::value_type>{};
+			for (auto const to : g.connections(0)) {
+				for (auto const w : g.weights(0, to)) {
+					moved.emplace_back(1, to == 0 ? 1 : to, w);
+				}
+			}
+			for (auto const& e : g.in_edges(0)) {
+				if (e.from != 0) {
+					moved.emplace_back(e.from, 1, e.weight);
+				}
+			}
+			for (auto const& e : moved) {
+				g.insert_edge(e);
+			}
+			g.erase_node(0);
+		});
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// Renames random nodes to values no node has.
+	template<typename E>
+	void replace_node(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto g = make_graph<E>(n);
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		auto names = std::vector<int>(static_cast<std::size_t>(n));
+		std::iota(names.begin(), names.end(), 0);
+		auto fresh = n;
+		for (auto _ : state) {
+			auto& name = names[static_cast<std::size_t>(node(engine))];
+			benchmark::DoNotOptimize(g.replace_node(name, fresh));
+			name = fresh++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(erase_node, int)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(erase_node, outgoing_weight)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(replace_node, int)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(replace_node, outgoing_weight)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(erase_hub_node, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(erase_hub_node, outgoing_weight)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(erase_hub_nodes, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(erase_hub_nodes, outgoing_weight)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(erase_hub_edges, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(erase_hub_edges_if, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(erase_hub_edges_one_by_one, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 100'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(merge_hubs)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(merge_hubs_by_reinserting)
+   ->RangeMultiplier(10)
+   ->Range(1'000, 100'000)
+   ->Unit(benchmark::kMillisecond);
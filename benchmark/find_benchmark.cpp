@@ -0,0 +1,70 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	template<typename N>
+	auto make_node(int const i) -> N {
+		if constexpr (std::is_same_v<N, std::string>) {
+			return "node-with-a-long-name-" + std::to_string(i);
+		}
+		else {
+			return i;
+		}
+	}
+
+	// n nodes with 8 random out-edges each; also returns the edges so queries can pick from them.
+	template<typename N>
+	auto make_graph(std::int64_t const n, std::vector<typename gdwg::graph<N, int>::value_type>& edges)
+	   -> gdwg::graph<N, int> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(make_node<N>(from), make_node<N>(node(engine)), weight(engine));
+			}
+		}
+		return gdwg::graph<N, int>(edges.begin(), edges.end());
+	}
+
+	// Looks up edges that are present, chosen uniformly.
+	template<typename N>
+	void find(benchmark::State& state) {
+		auto edges = std::vector<typename gdwg::graph<N, int>::value_type>{};
+		auto const g = make_graph<N>(state.range(0), edges);
+		auto engine = std::mt19937{1};
+		auto pick = std::uniform_int_distribution<std::size_t>(0, edges.size() - 1);
+		for (auto _ : state) {
+			auto const& e = edges[pick(engine)];
+			benchmark::DoNotOptimize(g.find(e.from, e.to, e.weight) != g.end());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Looks up edges between existing nodes with a weight no edge has.
+	template<typename N>
+	void find_missing(benchmark::State& state) {
+		auto edges = std::vector<typename gdwg::graph<N, int>::value_type>{};
+		auto const g = make_graph<N>(state.range(0), edges);
+		auto engine = std::mt19937{1};
+		auto pick = std::uniform_int_distribution<std::size_t>(0, edges.size() - 1);
+		for (auto _ : state) {
+			auto const& e = edges[pick(engine)];
+			benchmark::DoNotOptimize(g.find(e.from, e.to, -1) != g.end());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+} // namespace
+
+// 125'000 nodes with 8 out-edges each: 1M edges
+BENCHMARK_TEMPLATE(find, int)->Arg(125'000);
+BENCHMARK_TEMPLATE(find, std::string)->Arg(125'000);
+BENCHMARK_TEMPLATE(find_missing, int)->Arg(125'000);
+BENCHMARK_TEMPLATE(find_missing, std::string)->Arg(125'000);
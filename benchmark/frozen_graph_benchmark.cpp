@@ -0,0 +1,87 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, int>;
+
+	// n nodes with 8 random out-edges each.
+	auto make_graph(std::int64_t const n) -> graph {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto edges = std::vector<graph::value_type>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), weight(engine));
+			}
+		}
+		return graph(edges.begin(), edges.end());
+	}
+
+	template<typename G>
+	auto prepare(graph const& g) -> G {
+		if constexpr (std::is_same_v<G, graph>) {
+			return g;
+		}
+		else {
+			return g.freeze();
+		}
+	}
+
+	template<typename G>
+	void is_connected(benchmark::State& state) {
+		auto const g = prepare<G>(make_graph(state.range(0)));
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(state.range(0)) - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(node(engine), node(engine)));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	template<typename G>
+	void weights(benchmark::State& state) {
+		auto const g = prepare<G>(make_graph(state.range(0)));
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(state.range(0)) - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(node(engine), node(engine)));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	template<typename G>
+	void iterate(benchmark::State& state) {
+		auto const g = prepare<G>(make_graph(state.range(0)));
+		for (auto _ : state) {
+			auto sum = 0L;
+			for (auto const& [from, to, weight] : g) {
+				sum += weight;
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+	}
+
+	void freeze(benchmark::State& state) {
+		auto const g = make_graph(state.range(0));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.freeze());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+	}
+} // namespace
+
+using frozen = gdwg::frozen_graph<int, int>;
+BENCHMARK_TEMPLATE(is_connected, graph)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(is_connected, frozen)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(weights, graph)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(weights, frozen)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(iterate, graph)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(iterate, frozen)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK(freeze)->RangeMultiplier(10)->Range(1'000, 100'000);
@@ -0,0 +1,289 @@
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The graph<N, E> operation suite, run for graph<int, int> and graph<std::string, double> over
+// 10^3..10^5 nodes with 8 random out-edges each. Run it through the graph_benchmark_json target to
+// get results as JSON for regression tracking.
+
+namespace {
+	template<typename T>
+	auto make_value(int const i) -> T {
+		if constexpr (std::is_same_v<T, std::string>) {
+			// Longer than the small string buffer, as most real node names are
+			return "node-with-a-long-name-" + std::to_string(i);
+		}
+		else {
+			return static_cast<T>(i);
+		}
+	}
+
+	// Deterministic inputs: n nodes, each with 8 out-edges to random nodes.
+	template<typename N, typename E>
+	struct workload {
+		using graph = gdwg::graph<N, E>;
+
+		explicit workload(std::int64_t const size) {
+			auto const n = static_cast<int>(size);
+			auto engine = std::mt19937{6771};
+			auto node = std::uniform_int_distribution<int>(0, n - 1);
+			auto weight = std::uniform_int_distribution<int>(0, 100);
+			for (auto i = 0; i < n; ++i) {
+				nodes.push_back(make_value<N>(i));
+			}
+			for (auto const& from : nodes) {
+				for (auto i = 0; i < 8; ++i) {
+					auto const& to = nodes[static_cast<std::size_t>(node(engine))];
+					edges.emplace_back(from, to, make_value<E>(weight(engine)));
+				}
+			}
+		}
+
+		[[nodiscard]] auto build() const -> graph {
+			auto g = graph(nodes.begin(), nodes.end());
+			g.insert_edges(edges.begin(), edges.end());
+			return g;
+		}
+
+		std::vector<N> nodes;
+		std::vector<typename graph::value_type> edges;
+	};
+
+	// Builds the node set one insert_node at a time, in random order.
+	template<typename N, typename E>
+	void insert_node(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto nodes = w.nodes;
+		std::shuffle(nodes.begin(), nodes.end(), std::mt19937{1});
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, E>{};
+			for (auto const& n : nodes) {
+				g.insert_node(n);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+	}
+
+	// Adds every edge one insert_edge at a time to a graph that has all the nodes.
+	template<typename N, typename E>
+	void insert_edge(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, E>(w.nodes.begin(), w.nodes.end());
+			for (auto const& e : w.edges) {
+				g.insert_edge(e.from, e.to, e.weight);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.edges.size()));
+	}
+
+	// Looks up random edges that are present.
+	template<typename N, typename E>
+	void find(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const g = w.build();
+		auto engine = std::mt19937{1};
+		auto pick = std::uniform_int_distribution<std::size_t>(0, w.edges.size() - 1);
+		for (auto _ : state) {
+			auto const& e = w.edges[pick(engine)];
+			benchmark::DoNotOptimize(g.find(e.from, e.to, e.weight));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Weights between random connected pairs.
+	template<typename N, typename E>
+	void weights(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const g = w.build();
+		auto engine = std::mt19937{1};
+		auto pick = std::uniform_int_distribution<std::size_t>(0, w.edges.size() - 1);
+		for (auto _ : state) {
+			auto const& e = w.edges[pick(engine)];
+			benchmark::DoNotOptimize(g.weights(e.from, e.to));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Out-neighbours of random nodes.
+	template<typename N, typename E>
+	void connections(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const g = w.build();
+		auto engine = std::mt19937{1};
+		auto pick = std::uniform_int_distribution<std::size_t>(0, w.nodes.size() - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(w.nodes[pick(engine)]));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Erases nodes in random order, rebuilding the graph (untimed) once half of them are gone.
+	template<typename N, typename E>
+	void erase_node(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto engine = std::mt19937{1};
+		auto order = w.nodes;
+		auto g = gdwg::graph<N, E>{};
+		auto next = order.size() / 2;
+		for (auto _ : state) {
+			if (next == order.size() / 2) {
+				state.PauseTiming();
+				g = w.build();
+				std::shuffle(order.begin(), order.end(), engine);
+				next = 0;
+				state.ResumeTiming();
+			}
+			benchmark::DoNotOptimize(g.erase_node(order[next++]));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Merges disjoint random pairs of nodes, rebuilding the graph (untimed) once every node has been
+	// merged or merged into.
+	template<typename N, typename E>
+	void merge_replace_node(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto engine = std::mt19937{1};
+		auto order = w.nodes;
+		auto g = gdwg::graph<N, E>{};
+		auto next = order.size();
+		for (auto _ : state) {
+			if (next + 1 >= order.size()) {
+				state.PauseTiming();
+				g = w.build();
+				std::shuffle(order.begin(), order.end(), engine);
+				next = 0;
+				state.ResumeTiming();
+			}
+			g.merge_replace_node(order[next], order[next + 1]);
+			next += 2;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// A tick of ingest for edge_changes and batch: n / 10 changes, alternately inserting an edge
+	// from one of the busiest 1% of nodes and erasing one of the workload's, flagged true for
+	// insertions
+	template<typename N, typename E>
+	auto make_tick(workload<N, E> const& w)
+	   -> std::vector<std::pair<typename gdwg::graph<N, E>::value_type, bool>> {
+		auto engine = std::mt19937{1};
+		auto busy = std::uniform_int_distribution<std::size_t>(0, w.nodes.size() / 100);
+		auto node = std::uniform_int_distribution<std::size_t>(0, w.nodes.size() - 1);
+		auto edge = std::uniform_int_distribution<std::size_t>(0, w.edges.size() - 1);
+		auto tick = std::vector<std::pair<typename gdwg::graph<N, E>::value_type, bool>>{};
+		for (auto i = std::size_t{0}; i < w.nodes.size() / 10; ++i) {
+			if (i % 2 == 0) {
+				tick.emplace_back(typename gdwg::graph<N, E>::value_type{w.nodes[busy(engine)],
+				                                                         w.nodes[node(engine)],
+				                                                         make_value<E>(1000)},
+				                  true);
+			}
+			else {
+				tick.emplace_back(w.edges[edge(engine)], false);
+			}
+		}
+		return tick;
+	}
+
+	// Applies a tick one insert_edge or erase_edge at a time to a fresh copy of the graph, made and
+	// torn down untimed.
+	template<typename N, typename E>
+	void edge_changes(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const original = w.build();
+		auto const tick = make_tick(w);
+		auto g = gdwg::graph<N, E>{};
+		for (auto _ : state) {
+			state.PauseTiming();
+			g = original;
+			state.ResumeTiming();
+			for (auto const& [e, insert] : tick) {
+				benchmark::DoNotOptimize(insert ? g.insert_edge(e.from, e.to, e.weight)
+				                                : g.erase_edge(e.from, e.to, e.weight));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tick.size()));
+	}
+
+	// The same tick recorded in a batch and committed at once
+	template<typename N, typename E>
+	void batch(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const original = w.build();
+		auto const tick = make_tick(w);
+		auto g = gdwg::graph<N, E>{};
+		for (auto _ : state) {
+			state.PauseTiming();
+			g = original;
+			state.ResumeTiming();
+			auto changes = g.batch();
+			for (auto const& [e, insert] : tick) {
+				if (insert) {
+					changes.insert_edge(e.from, e.to, e.weight);
+				}
+				else {
+					changes.erase_edge(e.from, e.to, e.weight);
+				}
+			}
+			changes.commit();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tick.size()));
+	}
+
+	template<typename N, typename E>
+	void copy(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const g = w.build();
+		for (auto _ : state) {
+			auto copy = g;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.edges.size()));
+	}
+
+	template<typename N, typename E>
+	void output(benchmark::State& state) {
+		auto const w = workload<N, E>(state.range(0));
+		auto const g = w.build();
+		auto bytes = std::int64_t{0};
+		for (auto _ : state) {
+			auto out = std::ostringstream{};
+			out << g;
+			bytes += static_cast<std::int64_t>(out.view().size());
+			benchmark::DoNotOptimize(out);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(w.edges.size()));
+		state.SetBytesProcessed(bytes);
+	}
+} // namespace
+
+#define GDWG_GRAPH_BENCHMARK(name, first, last)                                                     \
+	BENCHMARK_TEMPLATE(name, int, int)->RangeMultiplier(10)->Range(first, last);                     \
+	BENCHMARK_TEMPLATE(name, std::string, double)->RangeMultiplier(10)->Range(first, last)
+
+// Each insert_node shifts the sorted node list, so building 10^5 nodes this way is quadratic.
+GDWG_GRAPH_BENCHMARK(insert_node, 1'000, 10'000);
+GDWG_GRAPH_BENCHMARK(insert_edge, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(find, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(weights, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(connections, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(erase_node, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(merge_replace_node, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(edge_changes, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(batch, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(copy, 1'000, 100'000);
+GDWG_GRAPH_BENCHMARK(output, 1'000, 100'000);
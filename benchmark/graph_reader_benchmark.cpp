@@ -0,0 +1,81 @@
+#include "gdwg/graph_reader.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parsing a graph<int, int> with 8 random out-edges per node, in MB/s: operator<<'s format from a
+// buffer and from a stream, and the same edges as an edge list.
+
+namespace {
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, int> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), weight(engine));
+			}
+		}
+		return gdwg::graph<int, int>(edges.begin(), edges.end());
+	}
+
+	auto graph_text(std::int64_t const n) -> std::string {
+		auto out = std::ostringstream{};
+		out << make_graph(n);
+		return out.str();
+	}
+
+	auto edge_list_text(std::int64_t const n) -> std::string {
+		auto out = std::ostringstream{};
+		for (auto const& e : make_graph(n)) {
+			out << e.from << ' ' << e.to << ' ' << e.weight << '\n';
+		}
+		return out.str();
+	}
+
+	void read_graph_buffer(benchmark::State& state) {
+		auto const text = graph_text(state.range(0));
+		for (auto _ : state) {
+			auto g = gdwg::read_graph<int, int>(std::string_view(text));
+			benchmark::DoNotOptimize(g.empty());
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+	}
+
+	void read_graph_stream(benchmark::State& state) {
+		auto const text = graph_text(state.range(0));
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto g = gdwg::read_graph<int, int>(in);
+			benchmark::DoNotOptimize(g.empty());
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+	}
+
+	void read_edge_list(benchmark::State& state) {
+		auto const text = edge_list_text(state.range(0));
+		for (auto _ : state) {
+			auto g = gdwg::read_graph<int, int>(std::string_view(text), gdwg::text_format::edge_list);
+			benchmark::DoNotOptimize(g.empty());
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+	}
+} // namespace
+
+BENCHMARK(read_graph_buffer)
+   ->RangeMultiplier(10)
+   ->Range(1'000, 100'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(read_graph_stream)
+   ->RangeMultiplier(10)
+   ->Range(1'000, 100'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(read_edge_list)
+   ->RangeMultiplier(10)
+   ->Range(1'000, 100'000)
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,69 @@
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<std::string, int>;
+
+	// n string nodes, long enough to defeat the small string optimisation, with 10 random
+	// out-edges each.
+	auto make_graph(std::int64_t const n) -> graph {
+		auto names = std::vector<std::string>{};
+		for (auto i = 0; i < n; ++i) {
+			names.push_back("node-with-a-long-name-" + std::to_string(i));
+		}
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<std::size_t>(0, names.size() - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto g = graph(names.begin(), names.end());
+		// Inserted a slice of sources at a time to keep the staging buffer small
+		auto edges = std::vector<graph::value_type>{};
+		for (auto first = std::size_t{0}; first < names.size(); first += 100'000) {
+			edges.clear();
+			for (auto from = first; from < std::min(first + 100'000, names.size()); ++from) {
+				for (auto i = 0; i < 10; ++i) {
+					edges.emplace_back(names[from], names[node(engine)], weight(engine));
+				}
+			}
+			g.insert_edges(edges.begin(), edges.end());
+		}
+		return g;
+	}
+
+	// Full edge scan through references into the graph.
+	void iterate(benchmark::State& state) {
+		auto const g = make_graph(state.range(0));
+		for (auto _ : state) {
+			auto total = std::size_t{0};
+			for (auto const& [from, to, weight] : g) {
+				total += from.size() + to.size() + static_cast<std::size_t>(weight);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 10);
+	}
+
+	// The same scan copying every edge into a value_type, as dereferencing used to.
+	void iterate_copy(benchmark::State& state) {
+		auto const g = make_graph(state.range(0));
+		for (auto _ : state) {
+			auto total = std::size_t{0};
+			for (auto it = g.begin(); it != g.end(); ++it) {
+				graph::value_type const edge = *it;
+				total += edge.from.size() + edge.to.size() + static_cast<std::size_t>(edge.weight);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 10);
+	}
+} // namespace
+
+// 10^6 nodes with 10 out-edges each: 10M edges
+BENCHMARK(iterate)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(iterate_copy)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+#include "gdwg/mapped_graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Getting a saved graph<int, int> with 8 random out-edges per node back into service: mapping the
+// file, reading it into a graph, or rebuilding the graph from its edges; then is_connected on the
+// mapping against the graph.
+
+namespace {
+	auto make_edges(std::int64_t const n) -> std::vector<gdwg::graph<int, int>::value_type> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), weight(engine));
+			}
+		}
+		return edges;
+	}
+
+	// Saves the graph of n nodes once and returns where
+	auto saved_graph(std::int64_t const n) -> std::filesystem::path {
+		auto path = std::filesystem::temp_directory_path()
+		            / ("gdwg_mapped_graph_benchmark_" + std::to_string(n));
+		if (!std::filesystem::exists(path)) {
+			auto const edges = make_edges(n);
+			gdwg::save(gdwg::graph<int, int>(edges.begin(), edges.end()), path);
+		}
+		return path;
+	}
+
+	void open_mapped(benchmark::State& state) {
+		auto const path = saved_graph(state.range(0));
+		for (auto _ : state) {
+			auto m = gdwg::mapped_graph<int, int>(path);
+			benchmark::DoNotOptimize(m.is_connected(0, 1));
+		}
+	}
+
+	void load(benchmark::State& state) {
+		auto const path = saved_graph(state.range(0));
+		for (auto _ : state) {
+			auto g = gdwg::load<int, int>(path);
+			benchmark::DoNotOptimize(g.is_connected(0, 1));
+		}
+	}
+
+	void rebuild(benchmark::State& state) {
+		auto const edges = make_edges(state.range(0));
+		for (auto _ : state) {
+			auto g = gdwg::graph<int, int>(edges.begin(), edges.end());
+			benchmark::DoNotOptimize(g.is_connected(0, 1));
+		}
+	}
+
+	template<typename G>
+	void is_connected(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto const g = [&] {
+			if constexpr (std::is_same_v<G, gdwg::graph<int, int>>) {
+				return gdwg::load<int, int>(saved_graph(n));
+			}
+			else {
+				return G(saved_graph(n));
+			}
+		}();
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(node(engine), node(engine)));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+} // namespace
+
+BENCHMARK(open_mapped)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(load)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(rebuild)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(is_connected, gdwg::graph<int, int>)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000);
+BENCHMARK_TEMPLATE(is_connected, gdwg::mapped_graph<int, int>)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000);
@@ -0,0 +1,92 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Counts live heap bytes so the benchmark can report the graph's footprint. The size is stashed
+// in front of each block because unsized operator delete does not receive it.
+namespace {
+	std::int64_t live_bytes = 0;
+	constexpr auto header = alignof(std::max_align_t);
+} // namespace
+
+auto operator new(std::size_t const size) -> void* {
+	auto* block = static_cast<std::byte*>(std::malloc(size + header)); // NOLINT
+	if (block == nullptr) {
+		throw std::bad_alloc{};
+	}
+	*reinterpret_cast<std::size_t*>(block) = size; // NOLINT
+	live_bytes += static_cast<std::int64_t>(size);
+	return block + header;
+}
+
+auto operator delete(void* const pointer) noexcept -> void {
+	if (pointer == nullptr) {
+		return;
+	}
+	auto* block = static_cast<std::byte*>(pointer) - header;
+	live_bytes -= static_cast<std::int64_t>(*reinterpret_cast<std::size_t*>(block)); // NOLINT
+	std::free(block); // NOLINT
+}
+
+auto operator delete(void* const pointer, std::size_t) noexcept -> void {
+	operator delete(pointer);
+}
+
+namespace {
+	template<typename T>
+	auto make_value(int const i) -> T {
+		if constexpr (std::is_same_v<T, std::string>) {
+			// Long enough to live outside the small string buffer.
+			return "node-with-a-long-name-" + std::to_string(i);
+		}
+		else {
+			return static_cast<T>(i);
+		}
+	}
+
+	// n nodes with 8 out-edges each and 64 distinct weights, built one edge at a time.
+	template<typename N, typename E>
+	void footprint(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 63);
+		auto edges = std::vector<std::tuple<N, N, E>>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(make_value<N>(from),
+				                   make_value<N>(node(engine)),
+				                   make_value<E>(weight(engine)));
+			}
+		}
+
+		auto bytes = std::int64_t{0};
+		auto edge_count = std::size_t{0};
+		for (auto _ : state) {
+			auto const before = live_bytes;
+			auto g = gdwg::graph<N, E>{};
+			for (auto i = 0; i < n; ++i) {
+				g.insert_node(make_value<N>(i));
+			}
+			for (auto const& [from, to, w] : edges) {
+				g.insert_edge(from, to, w);
+			}
+			bytes = live_bytes - before;
+			edge_count = static_cast<std::size_t>(std::distance(g.begin(), g.end()));
+			benchmark::DoNotOptimize(g);
+		}
+		state.counters["bytes_per_edge"] =
+		   static_cast<double>(bytes) / static_cast<double>(edge_count);
+		state.counters["bytes"] = static_cast<double>(bytes);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(footprint, int, int)->Arg(10'000)->Iterations(1);
+BENCHMARK_TEMPLATE(footprint, std::string, double)->Arg(10'000)->Iterations(1);
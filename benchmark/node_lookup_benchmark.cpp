@@ -0,0 +1,97 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+	// Same shape as an int node, but forced onto the binary-search index.
+	struct ordered_key {
+		int value;
+		auto operator<=>(ordered_key const&) const = default;
+	};
+} // namespace
+
+template<>
+inline constexpr auto gdwg::node_index_for<ordered_key> = gdwg::node_index::ordered;
+
+namespace {
+	// Keys 0, 2, 4, ... in shuffled (or ascending) order. Odd keys are never inserted, so they are
+	// guaranteed misses.
+	template<typename N>
+	auto make_keys(std::int64_t const n, int const offset = 0, bool const shuffled = true)
+	   -> std::vector<N> {
+		auto keys = std::vector<N>{};
+		keys.reserve(static_cast<std::size_t>(n));
+		for (auto i = std::int64_t{0}; i < n; ++i) {
+			keys.push_back(N{static_cast<int>(2 * i) + offset});
+		}
+		if (shuffled) {
+			std::shuffle(keys.begin(), keys.end(), std::mt19937{6771});
+		}
+		return keys;
+	}
+
+	// Builds a graph from ascending keys, so each insertion lands at the back of the node list.
+	template<typename N>
+	auto make_graph(std::int64_t const n) -> gdwg::graph<N, int> {
+		auto const keys = make_keys<N>(n, 0, false);
+		return gdwg::graph<N, int>(keys.begin(), keys.end());
+	}
+
+	// Ascending insertion measures the duplicate check and index upkeep; shuffled insertion also
+	// pays for shifting the sorted node list, so it is only run on smaller graphs.
+	template<typename N, bool Shuffled>
+	void insert_node(benchmark::State& state) {
+		auto const keys = make_keys<N>(state.range(0), 0, Shuffled);
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, int>{};
+			for (auto const& key : keys) {
+				g.insert_node(key);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// Alternates between a hit and a miss.
+	template<typename N>
+	void is_node(benchmark::State& state) {
+		auto const keys = make_keys<N>(state.range(0));
+		auto const misses = make_keys<N>(state.range(0), 1);
+		auto const g = make_graph<N>(state.range(0));
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_node(keys[i]));
+			benchmark::DoNotOptimize(g.is_node(misses[i]));
+			i = i + 1 == keys.size() ? 0 : i + 1;
+		}
+		state.SetItemsProcessed(2 * state.iterations());
+	}
+
+	// Every mutation and query looks its endpoints up first, so is_connected on a graph with no
+	// edges is dominated by node lookup.
+	template<typename N>
+	void is_connected(benchmark::State& state) {
+		auto const keys = make_keys<N>(state.range(0));
+		auto const g = make_graph<N>(state.range(0));
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const j = i + 1 == keys.size() ? 0 : i + 1;
+			benchmark::DoNotOptimize(g.is_connected(keys[i], keys[j]));
+			i = j;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+} // namespace
+
+// int uses the hashed index, ordered_key the binary-search index; both hold the same keys.
+BENCHMARK_TEMPLATE(insert_node, int, false)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK_TEMPLATE(insert_node, ordered_key, false)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK_TEMPLATE(insert_node, int, true)->RangeMultiplier(10)->Range(1'000, 10'000);
+BENCHMARK_TEMPLATE(insert_node, ordered_key, true)->RangeMultiplier(10)->Range(1'000, 10'000);
+BENCHMARK_TEMPLATE(is_node, int)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK_TEMPLATE(is_node, ordered_key)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK_TEMPLATE(is_connected, int)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK_TEMPLATE(is_connected, ordered_key)->RangeMultiplier(10)->Range(1'000, 10'000'000);
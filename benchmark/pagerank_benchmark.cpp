@@ -0,0 +1,102 @@
+#include "gdwg/algorithm.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+// pagerank of a graph<int, int> with 16 random out-edges per node on 1 to 32 threads, against a
+// textbook single-threaded version pushing scores along adjacency lists built outside the timed
+// loop. The pull kernel alone is also timed against the same loop with a single sum, over the
+// transposed matrix both share. Scaling needs as many cores as threads.
+
+namespace {
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, int> const& {
+		static auto graphs = std::map<std::int64_t, gdwg::graph<int, int>>{};
+		auto& g = graphs[n];
+		if (g.empty()) {
+			auto engine = std::mt19937{6771};
+			auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+			auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+			for (auto from = 0; from < n; ++from) {
+				for (auto i = 0; i < 16; ++i) {
+					edges.emplace_back(from, node(engine), 1);
+				}
+			}
+			g = gdwg::graph<int, int>(edges.begin(), edges.end());
+		}
+		return g;
+	}
+
+	void pagerank(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		auto const options = gdwg::pagerank_options{
+		   .tolerance = 0,
+		   .max_iterations = 20,
+		   .threads = static_cast<std::size_t>(state.range(1)),
+		};
+		for (auto _ : state) {
+			auto const ranks = gdwg::pagerank(g, options);
+			benchmark::DoNotOptimize(ranks.score(0));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 16 * 20);
+	}
+
+	void push(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto adjacent = std::vector<std::vector<int>>(n);
+		for (auto const& e : g) {
+			adjacent[static_cast<std::size_t>(e.from)].push_back(e.to);
+		}
+		for (auto _ : state) {
+			auto scores = std::vector<double>(n, 1.0 / static_cast<double>(n));
+			for (auto round = 0; round < 20; ++round) {
+				auto next = std::vector<double>(n, 0.15 / static_cast<double>(n));
+				for (auto from = std::size_t{0}; from < n; ++from) {
+					auto const share = 0.85 * scores[from] / static_cast<double>(adjacent[from].size());
+					for (auto const to : adjacent[from]) {
+						next[static_cast<std::size_t>(to)] += share;
+					}
+				}
+				scores.swap(next);
+			}
+			benchmark::DoNotOptimize(scores.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 16 * 20);
+	}
+
+	// One multiplication by the transposed matrix, with the four sums of detail::pull or one
+	template<bool Split>
+	void kernel(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		auto const m = gdwg::detail::incoming<int, int>(gdwg::detail::graph_view<int, int>{&g});
+		auto const x = std::vector<double>(m.size(), 1.0);
+		auto y = std::vector<double>(m.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < m.size(); ++i) {
+				if constexpr (Split) {
+					y[i] = gdwg::detail::pull(m, x.data(), i);
+				}
+				else {
+					auto sum = 0.0;
+					for (auto k = m.offsets[i]; k < m.offsets[i + 1]; ++k) {
+						sum += x[m.sources[k]];
+					}
+					y[i] = sum;
+				}
+			}
+			benchmark::DoNotOptimize(y.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 16);
+	}
+} // namespace
+
+BENCHMARK(pagerank)
+   ->ArgsProduct({{100'000, 1'000'000}, benchmark::CreateRange(1, 32, 2)})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+BENCHMARK(push)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(kernel, true)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(kernel, false)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
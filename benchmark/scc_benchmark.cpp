@@ -0,0 +1,98 @@
+#include "gdwg/algorithm.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+// strongly_connected_components and condensation of a graph<int, int> with 8 random out-edges per
+// node, topological_order of one whose edges all go to greater nodes, and strongly_connected_
+// components of a single path up to 10^7 nodes long, where a recursive search would run out of
+// stack.
+
+namespace {
+	enum class shape { random, acyclic, path };
+
+	auto make_graph(shape const kind, std::int64_t const n) -> gdwg::graph<int, int> const& {
+		static auto graphs = std::map<std::pair<shape, std::int64_t>, gdwg::graph<int, int>>{};
+		auto& g = graphs[{kind, n}];
+		if (!g.empty()) {
+			return g;
+		}
+		auto engine = std::mt19937{6771};
+		auto nodes = std::vector<int>(static_cast<std::size_t>(n));
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto from = 0; from < n; ++from) {
+			nodes[static_cast<std::size_t>(from)] = from;
+			if (kind == shape::path) {
+				if (from + 1 < n) {
+					edges.emplace_back(from, from + 1, 1);
+				}
+				continue;
+			}
+			auto node = std::uniform_int_distribution<int>(kind == shape::random ? 0 : from,
+			                                               static_cast<int>(n) - 1);
+			for (auto i = 0; i < 8; ++i) {
+				auto const to = node(engine);
+				if (kind == shape::random || to != from) {
+					edges.emplace_back(from, to, 1);
+				}
+			}
+		}
+		g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		g.insert_edges(edges.begin(), edges.end());
+		return g;
+	}
+
+	void components(benchmark::State& state) {
+		auto const& g = make_graph(shape::random, state.range(0));
+		for (auto _ : state) {
+			auto const scc = gdwg::strongly_connected_components(g);
+			benchmark::DoNotOptimize(scc.size());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void condensation(benchmark::State& state) {
+		auto const& g = make_graph(shape::random, state.range(0));
+		for (auto _ : state) {
+			auto const dag = gdwg::condensation(g);
+			benchmark::DoNotOptimize(dag.empty());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void topological_order(benchmark::State& state) {
+		auto const& g = make_graph(shape::acyclic, state.range(0));
+		for (auto _ : state) {
+			auto const order = gdwg::topological_order(g);
+			benchmark::DoNotOptimize(order.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void path_components(benchmark::State& state) {
+		auto const& g = make_graph(shape::path, state.range(0));
+		for (auto _ : state) {
+			auto const scc = gdwg::strongly_connected_components(g);
+			benchmark::DoNotOptimize(scc.size());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+BENCHMARK(components)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(condensation)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(topological_order)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK(path_components)
+   ->RangeMultiplier(10)
+   ->Range(100'000, 10'000'000)
+   ->Unit(benchmark::kMillisecond);
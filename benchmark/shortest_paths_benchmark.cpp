@@ -0,0 +1,99 @@
+#include "gdwg/algorithm.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+// shortest_paths from one node of a graph<int, E> with 8 random out-edges per node and weights in
+// [1, 1000]: int weights take the radix heap, long weights the 4-ary heap, and both are compared
+// with a textbook Dijkstra over std::priority_queue. The textbook version's adjacency lists are
+// built outside the timed loop, while shortest_paths builds its own inside it.
+
+template<>
+inline constexpr auto gdwg::shortest_path_heap_for<long> = gdwg::shortest_path_heap::d_ary;
+
+namespace {
+	template<typename E>
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, E> const& {
+		static auto graphs = std::map<std::int64_t, gdwg::graph<int, E>>{};
+		auto& g = graphs[n];
+		if (g.empty()) {
+			auto engine = std::mt19937{6771};
+			auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+			auto weight = std::uniform_int_distribution<int>(1, 1000);
+			auto edges = std::vector<typename gdwg::graph<int, E>::value_type>{};
+			for (auto from = 0; from < n; ++from) {
+				for (auto i = 0; i < 8; ++i) {
+					edges.emplace_back(from, node(engine), static_cast<E>(weight(engine)));
+				}
+			}
+			g = gdwg::graph<int, E>(edges.begin(), edges.end());
+		}
+		return g;
+	}
+
+	template<typename E>
+	void shortest_paths(benchmark::State& state) {
+		auto const& g = make_graph<E>(state.range(0));
+		for (auto _ : state) {
+			auto paths = gdwg::shortest_paths(g, 0);
+			benchmark::DoNotOptimize(paths.distance(1));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename E>
+	void priority_queue(benchmark::State& state) {
+		auto const& g = make_graph<E>(state.range(0));
+		auto adjacent = std::vector<std::vector<std::pair<int, E>>>(g.nodes().size());
+		for (auto const& e : g) {
+			adjacent[static_cast<std::size_t>(e.from)].emplace_back(e.to, e.weight);
+		}
+		using entry = std::pair<E, int>;
+		for (auto _ : state) {
+			auto distances = std::vector<E>(adjacent.size(), std::numeric_limits<E>::max());
+			auto queue = std::priority_queue<entry, std::vector<entry>, std::greater<>>{};
+			distances[0] = 0;
+			queue.emplace(0, 0);
+			while (!queue.empty()) {
+				auto const [distance, from] = queue.top();
+				queue.pop();
+				if (distances[static_cast<std::size_t>(from)] < distance) {
+					continue;
+				}
+				for (auto const& [to, weight] : adjacent[static_cast<std::size_t>(from)]) {
+					auto& best = distances[static_cast<std::size_t>(to)];
+					if (distance + weight < best) {
+						best = distance + weight;
+						queue.emplace(best, to);
+					}
+				}
+			}
+			benchmark::DoNotOptimize(distances.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(shortest_paths, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(shortest_paths, long)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(priority_queue, int)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(priority_queue, long)
+   ->RangeMultiplier(10)
+   ->Range(10'000, 1'000'000)
+   ->Unit(benchmark::kMillisecond);
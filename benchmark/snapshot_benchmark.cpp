@@ -0,0 +1,82 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+	// Same values as int, but copied with copy_on_write.
+	enum class shared_weight : int {};
+} // namespace
+
+template<>
+inline constexpr auto gdwg::copy_mode_for<int, shared_weight> = gdwg::copy_mode::copy_on_write;
+
+namespace {
+	// n nodes with 8 random out-edges each.
+	template<typename E>
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, E> {
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto edges = std::vector<typename gdwg::graph<int, E>::value_type>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), E{weight(engine)});
+			}
+		}
+		return gdwg::graph<int, E>(edges.begin(), edges.end());
+	}
+
+	template<typename E>
+	void snapshot(benchmark::State& state) {
+		auto const g = make_graph<E>(state.range(0));
+		for (auto _ : state) {
+			auto copy = g;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// A writer that snapshots its graph before every edge insertion, as when handing a copy to a
+	// reader after each change.
+	template<typename E>
+	void snapshot_and_insert_edge(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto g = make_graph<E>(n);
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		auto weight = 1000;
+		for (auto _ : state) {
+			auto copy = g;
+			benchmark::DoNotOptimize(g.insert_edge(node(engine), node(engine), E{weight++}));
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Lookups on a graph whose storage is shared with a snapshot.
+	template<typename E>
+	void find(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto const g = make_graph<E>(n);
+		auto const copy = g;
+		auto engine = std::mt19937{1};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.find(node(engine), node(engine), E{0}));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(snapshot, int)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(snapshot, shared_weight)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(snapshot_and_insert_edge, int)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(snapshot_and_insert_edge, shared_weight)
+   ->RangeMultiplier(10)
+   ->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(find, int)->RangeMultiplier(10)->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(find, shared_weight)->RangeMultiplier(10)->Range(1'000, 100'000);
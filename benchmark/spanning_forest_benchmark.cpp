@@ -0,0 +1,92 @@
+#include "gdwg/algorithm.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+// minimum_spanning_forest of a graph<int, int> with 8 random out-edges per node and weights in
+// [1, 1000]: Kruskal's with one thread and Borůvka's with 2 to 32, against a textbook Kruskal's
+// sorting copies of every edge taken through the graph's iterators. weakly_connected_components
+// is timed on the same graphs. Scaling needs as many cores as threads.
+
+namespace {
+	auto make_graph(std::int64_t const n) -> gdwg::graph<int, int> const& {
+		static auto graphs = std::map<std::int64_t, gdwg::graph<int, int>>{};
+		auto& g = graphs[n];
+		if (g.empty()) {
+			auto engine = std::mt19937{6771};
+			auto node = std::uniform_int_distribution<int>(0, static_cast<int>(n) - 1);
+			auto weight = std::uniform_int_distribution<int>(1, 1000);
+			auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+			for (auto from = 0; from < n; ++from) {
+				for (auto i = 0; i < 8; ++i) {
+					edges.emplace_back(from, node(engine), weight(engine));
+				}
+			}
+			g = gdwg::graph<int, int>(edges.begin(), edges.end());
+		}
+		return g;
+	}
+
+	void spanning_forest(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		auto const threads = static_cast<std::size_t>(state.range(1));
+		for (auto _ : state) {
+			auto const forest = gdwg::minimum_spanning_forest(g, threads);
+			benchmark::DoNotOptimize(forest.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+	}
+
+	void textbook_kruskal(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		for (auto _ : state) {
+			auto edges = std::vector<gdwg::graph<int, int>::value_type>(g.begin(), g.end());
+			std::stable_sort(edges.begin(), edges.end(), [](auto const& a, auto const& b) {
+				return a.weight < b.weight;
+			});
+			auto parents = std::vector<int>(static_cast<std::size_t>(state.range(0)));
+			for (auto i = std::size_t{0}; i < parents.size(); ++i) {
+				parents[i] = static_cast<int>(i);
+			}
+			auto const root = [&](int x) {
+				while (parents[static_cast<std::size_t>(x)] != x) {
+					auto& parent = parents[static_cast<std::size_t>(x)];
+					parent = parents[static_cast<std::size_t>(parent)];
+					x = parent;
+				}
+				return x;
+			};
+			auto forest = std::vector<gdwg::graph<int, int>::value_type>{};
+			for (auto const& e : edges) {
+				auto const a = root(e.from);
+				auto const b = root(e.to);
+				if (a != b) {
+					parents[static_cast<std::size_t>(a)] = b;
+					forest.push_back(e);
+				}
+			}
+			benchmark::DoNotOptimize(forest.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+	}
+
+	void weak_components(benchmark::State& state) {
+		auto const& g = make_graph(state.range(0));
+		for (auto _ : state) {
+			auto const components = gdwg::weakly_connected_components(g);
+			benchmark::DoNotOptimize(components.size());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+	}
+} // namespace
+
+BENCHMARK(spanning_forest)
+   ->ArgsProduct({{100'000, 1'000'000}, benchmark::CreateRange(1, 32, 2)})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+BENCHMARK(textbook_kruskal)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(weak_components)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
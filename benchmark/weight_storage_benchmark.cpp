@@ -0,0 +1,61 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	// A 64-bit scalar that opts back into the weight pool, to compare against direct storage of the
+	// same values.
+	enum class pooled_weight : std::int64_t {};
+} // namespace
+
+template<>
+inline constexpr auto gdwg::weight_storage_for<pooled_weight> = gdwg::weight_storage::interned;
+
+namespace {
+	template<typename E>
+	auto make_weight(int const i) -> E {
+		if constexpr (std::is_same_v<E, std::string>) {
+			return "weight-with-a-long-name-" + std::to_string(i);
+		}
+		else {
+			return E{i};
+		}
+	}
+
+	// Inserts 8 out-edges per node, one at a time, drawing weights from range(1) distinct values.
+	template<typename E>
+	void insert_edge(benchmark::State& state) {
+		auto const n = static_cast<int>(state.range(0));
+		auto engine = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		auto weight = std::uniform_int_distribution<int>(0, static_cast<int>(state.range(1)) - 1);
+		auto edges = std::vector<std::tuple<int, int, E>>{};
+		for (auto from = 0; from < n; ++from) {
+			for (auto i = 0; i < 8; ++i) {
+				edges.emplace_back(from, node(engine), make_weight<E>(weight(engine)));
+			}
+		}
+		auto nodes = std::vector<int>(static_cast<std::size_t>(n));
+		std::iota(nodes.begin(), nodes.end(), 0);
+
+		for (auto _ : state) {
+			auto g = gdwg::graph<int, E>(nodes.begin(), nodes.end());
+			for (auto const& [from, to, w] : edges) {
+				g.insert_edge(from, to, w);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(insert_edge, std::int64_t)->Args({10'000, 64})->Args({10'000, 100'000});
+BENCHMARK_TEMPLATE(insert_edge, pooled_weight)->Args({10'000, 64})->Args({10'000, 100'000});
+BENCHMARK_TEMPLATE(insert_edge, std::string)->Args({10'000, 64})->Args({10'000, 100'000});
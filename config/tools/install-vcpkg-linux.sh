@@ -15,6 +15,6 @@ cd vcpkg
 git pull
 ./bootstrap-vcpkg.sh -disableMetrics
 cp ../config/cmake/triplets/* triplets/community/.
-./vcpkg install --clean-after-build catch2:x64-linux-libcxx
+./vcpkg install --clean-after-build catch2:x64-linux-libcxx benchmark:x64-linux-libcxx
 cd ..
 sed -i 's#/import/kamen/1/cs6771#${workspaceFolder}#' .vscode/cmake-kits.json
@@ -0,0 +1,1687 @@
+#ifndef GDWG_ALGORITHM_HPP
+#define GDWG_ALGORITHM_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Read access to a graph's storage by node id. Ids run from 0 to id_limit(), with unused
+		// ids for erased nodes; ids() lists the ones in use, sorted by value. Out-edges of a node
+		// are in (to, weight) order, and an edge's to is an id.
+		template<typename N, typename E>
+		struct graph_view {
+			using graph_type = graph<N, E>;
+			using node_id = typename graph_type::node_id;
+			static constexpr node_id no_node = graph_type::no_node;
+			// Whether sources() is available; see edge_index
+			static constexpr bool has_sources = graph_type::in_index;
+
+			graph_type const* g;
+
+			[[nodiscard]] auto id_limit() const noexcept -> std::size_t {
+				return g->out_edges_.size();
+			}
+			[[nodiscard]] auto ids() const noexcept -> std::vector<node_id> const& {
+				return g->nodes_->list;
+			}
+			[[nodiscard]] auto value(node_id const id) const -> N const& {
+				return g->value_of(id);
+			}
+			// Id of value, or no_node
+			[[nodiscard]] auto locate(N const& value) const -> node_id {
+				return g->locate_node(value);
+			}
+			[[nodiscard]] auto out_edges(node_id const id) const -> auto const& {
+				return g->edges_of(id);
+			}
+			template<typename OutEdge>
+			[[nodiscard]] auto weight(OutEdge const& e) const -> E const& {
+				return g->weight_of(e.weight);
+			}
+			// Nodes with an edge to id, once each and in no particular order
+			[[nodiscard]] auto sources(node_id const id) const -> std::vector<node_id> const&
+			requires has_sources
+			{
+				return *g->in_sources_[id];
+			}
+		};
+
+		// Index-based copy of a graph's edges. Node i is the i-th smallest node, and its out-edges
+		// are entries [offsets[i], offsets[i + 1]) of targets and weights, in the graph's (to,
+		// weight) order. Refers to the graph for node values, so the graph must not change while
+		// this is in use.
+		template<typename N, typename E>
+		struct adjacency {
+			using index_type = std::uint32_t;
+			static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+			explicit adjacency(graph_view<N, E> of);
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return view.ids().size();
+			}
+			// Index of value, or npos if it is not a node
+			[[nodiscard]] auto index_of(N const& value) const -> index_type {
+				auto const id = view.locate(value);
+				return id == view.no_node ? npos : positions[id];
+			}
+			[[nodiscard]] auto node(index_type const i) const -> N const& {
+				return view.value(view.ids()[i]);
+			}
+
+			graph_view<N, E> view;
+			// Index of each node id
+			std::vector<index_type> positions;
+			std::vector<std::size_t> offsets;
+			std::vector<index_type> targets{};
+			std::vector<E> weights{};
+		};
+
+		template<typename N, typename E>
+		adjacency<N, E>::adjacency(graph_view<N, E> const of)
+		: view{of}
+		, positions(of.id_limit(), npos)
+		, offsets(of.ids().size() + 1, 0) {
+			auto const& ids = view.ids();
+			for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+				positions[ids[i]] = static_cast<index_type>(i);
+				offsets[i + 1] = offsets[i] + view.out_edges(ids[i]).size();
+			}
+			targets.reserve(offsets.back());
+			weights.reserve(offsets.back());
+			for (auto const id : ids) {
+				for (auto const& e : view.out_edges(id)) {
+					targets.push_back(positions[e.to]);
+					weights.push_back(view.weight(e));
+				}
+			}
+		}
+
+		// Outcome of a search from one node: every node, sorted, and the index of the node each
+		// was reached from
+		template<typename N>
+		struct search_tree {
+			using index_type = std::uint32_t;
+			static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+			std::vector<N> nodes{};
+			// The source's own index for the source, and npos for nodes not reached
+			std::vector<index_type> parents{};
+			index_type source = npos;
+
+			// Index of value, throwing on behalf of function if it is not a node
+			auto index_of(N const& value, char const* const function) const -> index_type {
+				auto const it = std::lower_bound(nodes.begin(), nodes.end(), value);
+				if (it == nodes.end() || !(*it == value)) {
+					throw std::runtime_error(std::string("Cannot call ") + function
+					                         + " if dst doesn't exist in the graph");
+				}
+				return static_cast<index_type>(it - nodes.begin());
+			}
+			[[nodiscard]] auto reached(index_type const i) const -> bool {
+				return parents[i] != npos;
+			}
+			[[nodiscard]] auto parent(index_type const i) const -> std::optional<N> {
+				if (!reached(i) || i == source) {
+					return std::nullopt;
+				}
+				return nodes[parents[i]];
+			}
+			// Nodes from the source to i, both included, or empty if i was not reached
+			[[nodiscard]] auto path_to(index_type i) const -> std::vector<N> {
+				auto path = std::vector<N>{};
+				if (!reached(i)) {
+					return path;
+				}
+				path.push_back(nodes[i]);
+				while (i != source) {
+					i = parents[i];
+					path.push_back(nodes[i]);
+				}
+				std::reverse(path.begin(), path.end());
+				return path;
+			}
+		};
+
+		template<typename Key>
+		struct heap_entry {
+			Key key;
+			std::uint32_t node;
+		};
+
+		// Min-heap of nodes by key with decrease-key, four children to a parent. Entries hold their
+		// keys, so sifting compares adjacent memory rather than looking keys up by node.
+		template<typename Key>
+		class d_ary_heap {
+		public:
+			explicit d_ary_heap(std::size_t const node_count)
+			: positions_(node_count, npos) {}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return entries_.empty();
+			}
+			// Queues node with key, or lowers its key to key if it is already queued
+			auto push(std::uint32_t const node, Key const key) -> void {
+				auto i = std::size_t{positions_[node]};
+				if (i == npos) {
+					i = entries_.size();
+					entries_.push_back({key, node});
+				}
+				else {
+					entries_[i].key = key;
+				}
+				sift_up(i);
+			}
+			auto pop() -> heap_entry<Key> {
+				auto const top = entries_.front();
+				positions_[top.node] = npos;
+				auto const last = entries_.back();
+				entries_.pop_back();
+				if (!entries_.empty()) {
+					sift_down(last);
+				}
+				return top;
+			}
+
+		private:
+			static constexpr std::size_t arity = 4;
+			static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+			std::vector<heap_entry<Key>> entries_{};
+			// Position in entries_ of each queued node, or npos
+			std::vector<std::uint32_t> positions_;
+
+			auto place(std::size_t const i, heap_entry<Key> const& entry) -> void {
+				entries_[i] = entry;
+				positions_[entry.node] = static_cast<std::uint32_t>(i);
+			}
+			auto sift_up(std::size_t i) -> void {
+				auto const entry = entries_[i];
+				while (i > 0) {
+					auto const parent = (i - 1) / arity;
+					if (!(entry.key < entries_[parent].key)) {
+						break;
+					}
+					place(i, entries_[parent]);
+					i = parent;
+				}
+				place(i, entry);
+			}
+			// Fills the hole left at the root with entry
+			auto sift_down(heap_entry<Key> const& entry) -> void {
+				auto i = std::size_t{0};
+				while (true) {
+					auto const first = i * arity + 1;
+					if (first >= entries_.size()) {
+						break;
+					}
+					auto const last = std::min(first + arity, entries_.size());
+					auto best = first;
+					for (auto child = first + 1; child < last; ++child) {
+						if (entries_[child].key < entries_[best].key) {
+							best = child;
+						}
+					}
+					if (!(entries_[best].key < entry.key)) {
+						break;
+					}
+					place(i, entries_[best]);
+					i = best;
+				}
+				place(i, entry);
+			}
+		};
+
+		// Monotone min-queue for non-negative integer keys: no key pushed may be less than the last
+		// one popped, which Dijkstra's algorithm guarantees. Entries sit in a bucket per highest bit
+		// in which they differ from the last key popped, and each entry moves to a lower bucket at
+		// most 64 times, so pops are amortised O(log C) for keys up to C with no comparisons
+		// between entries. There is no decrease-key: a node is pushed again with its lower key
+		// and the stale entry is skipped when it comes out.
+		template<typename Key>
+		class radix_heap {
+		public:
+			explicit radix_heap(std::size_t /* node_count */) {}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return size_ == 0;
+			}
+			auto push(std::uint32_t const node, Key const key) -> void {
+				buckets_[bucket_of(key)].push_back({key, node});
+				++size_;
+			}
+			auto pop() -> heap_entry<Key> {
+				if (buckets_[0].empty()) {
+					auto i = std::size_t{1};
+					while (buckets_[i].empty()) {
+						++i;
+					}
+					// Rebase on the least key in the first non-empty bucket, which spreads its entries
+					// over lower buckets.
+					auto& bucket = buckets_[i];
+					auto least = bucket.front().key;
+					for (auto const& entry : bucket) {
+						least = std::min(least, entry.key);
+					}
+					last_ = bits(least);
+					for (auto const& entry : bucket) {
+						buckets_[bucket_of(entry.key)].push_back(entry);
+					}
+					bucket.clear();
+				}
+				auto const top = buckets_[0].back();
+				buckets_[0].pop_back();
+				--size_;
+				return top;
+			}
+
+		private:
+			std::array<std::vector<heap_entry<Key>>, 65> buckets_{};
+			std::uint64_t last_ = 0;
+			std::size_t size_ = 0;
+
+			static auto bits(Key const key) -> std::uint64_t {
+				return static_cast<std::uint64_t>(key);
+			}
+			auto bucket_of(Key const key) const -> std::size_t {
+				return static_cast<std::size_t>(std::bit_width(bits(key) ^ last_));
+			}
+		};
+
+		// Dijkstra's algorithm from source over a's rows and weights. Fills in distances and
+		// predecessors for each node reached; predecessors of the others stay npos.
+		template<typename N, typename E, typename Heap>
+		auto dijkstra(adjacency<N, E> const& a,
+		              typename adjacency<N, E>::index_type const source,
+		              Heap heap,
+		              std::vector<E>& distances,
+		              std::vector<typename adjacency<N, E>::index_type>& predecessors) -> void {
+			constexpr auto npos = adjacency<N, E>::npos;
+			distances[source] = E{};
+			predecessors[source] = source;
+			heap.push(source, E{});
+			while (!heap.empty()) {
+				auto const [distance, from] = heap.pop();
+				if (distances[from] < distance) {
+					continue;
+				}
+				for (auto e = a.offsets[from]; e < a.offsets[from + 1]; ++e) {
+					auto const to = a.targets[e];
+					auto const through = static_cast<E>(distance + a.weights[e]);
+					if (predecessors[to] == npos || through < distances[to]) {
+						distances[to] = through;
+						predecessors[to] = from;
+						heap.push(to, through);
+					}
+				}
+			}
+		}
+	} // namespace detail
+
+	// Weights shortest_paths can add up and compare.
+	template<typename E>
+	concept path_weight = std::is_arithmetic_v<E> && !std::same_as<E, bool>;
+
+	// Priority queue shortest_paths uses for a weight type.
+	//   d_ary - a 4-ary heap with decrease-key. Works for any path_weight.
+	//   radix - a radix heap, which buckets distances by their bits instead of comparing them.
+	//           Integral weights only.
+	enum class shortest_path_heap { d_ary, radix };
+
+	// Heap used for a given weight type. Specialise this to override the default, e.g.
+	//   template<>
+	//   inline constexpr auto gdwg::shortest_path_heap_for<long> = gdwg::shortest_path_heap::d_ary;
+	template<typename E>
+	inline constexpr auto shortest_path_heap_for =
+	   std::integral<E> ? shortest_path_heap::radix : shortest_path_heap::d_ary;
+
+	// Shortest distances from one node to every other in a graph<N, E> with non-negative weights,
+	// and the last step of a shortest path to each. Built by shortest_paths; independent of the
+	// graph once built.
+	//
+	// Runs Dijkstra's algorithm in O((V + E) log V) over an index-based copy of the graph's edges.
+	// Distances add up in E, so integral weights can overflow on long paths.
+	template<typename N, typename E>
+	requires path_weight<E>
+	class shortest_path_tree {
+	public:
+		// Throws if src is not a node or any weight is negative
+		shortest_path_tree(graph<N, E> const& g, N const& src);
+
+		[[nodiscard]] auto source() const -> N const& {
+			return tree_.nodes[tree_.source];
+		}
+		// The following throw if dst is not a node of the graph
+		[[nodiscard]] auto is_reachable(N const& dst) const -> bool {
+			return tree_.reached(tree_.index_of(dst, "gdwg::shortest_path_tree<N, E>::is_reachable"));
+		}
+		// Length of a shortest path from source() to dst, or nothing if there is none
+		[[nodiscard]] auto distance(N const& dst) const -> std::optional<E> {
+			auto const i = tree_.index_of(dst, "gdwg::shortest_path_tree<N, E>::distance");
+			return tree_.reached(i) ? std::optional<E>(distances_[i]) : std::nullopt;
+		}
+		// Node before dst on a shortest path from source(), or nothing for source() itself and
+		// nodes that cannot be reached
+		[[nodiscard]] auto predecessor(N const& dst) const -> std::optional<N> {
+			return tree_.parent(tree_.index_of(dst, "gdwg::shortest_path_tree<N, E>::predecessor"));
+		}
+		// Nodes of a shortest path from source() to dst, both included, or empty if there is none
+		[[nodiscard]] auto path_to(N const& dst) const -> std::vector<N> {
+			return tree_.path_to(tree_.index_of(dst, "gdwg::shortest_path_tree<N, E>::path_to"));
+		}
+
+	private:
+		detail::search_tree<N> tree_{};
+		std::vector<E> distances_{};
+	};
+
+	// Shortest paths from src to every node of g; see shortest_path_tree.
+	template<typename N, typename E>
+	requires path_weight<E>
+	auto shortest_paths(graph<N, E> const& g, N const& src) -> shortest_path_tree<N, E> {
+		return shortest_path_tree<N, E>(g, src);
+	}
+
+	template<typename N, typename E>
+	requires path_weight<E>
+	shortest_path_tree<N, E>::shortest_path_tree(graph<N, E> const& g, N const& src) {
+		auto const a = detail::adjacency<N, E>(detail::graph_view<N, E>{&g});
+		auto const source = a.index_of(src);
+		if (source == a.npos) {
+			throw std::runtime_error("Cannot call gdwg::shortest_paths if src doesn't exist in the "
+			                         "graph");
+		}
+		if (std::any_of(a.weights.begin(), a.weights.end(), [](E const w) { return w < E{}; })) {
+			throw std::runtime_error("Cannot call gdwg::shortest_paths on a graph with negative "
+			                         "weights");
+		}
+
+		tree_.source = source;
+		tree_.parents.assign(a.size(), a.npos);
+		distances_.assign(a.size(), E{});
+		if constexpr (shortest_path_heap_for<E> == shortest_path_heap::radix) {
+			static_assert(std::integral<E>, "The radix heap only takes integral weights");
+			detail::dijkstra(a, source, detail::radix_heap<E>(a.size()), distances_, tree_.parents);
+		}
+		else {
+			detail::dijkstra(a, source, detail::d_ary_heap<E>(a.size()), distances_, tree_.parents);
+		}
+
+		tree_.nodes.reserve(a.size());
+		for (auto i = std::uint32_t{0}; i < a.size(); ++i) {
+			tree_.nodes.push_back(a.node(i));
+		}
+	}
+
+	namespace detail {
+		// Direction-optimising breadth-first search (Beamer et al.) over a graph's own buckets,
+		// shared between threads by level. Each level either goes top-down, with the frontier's
+		// out-edges claiming unvisited nodes by compare-and-swap, or bottom-up, with each unvisited
+		// node looking for a parent in the frontier among its sources and stopping at the first.
+		// Bottom-up wins once the frontier holds a good part of the remaining edges, and needs the
+		// graph's reverse index; without one every level goes top-down.
+		//
+		// Frontiers are bitmaps over node ids, handed out to threads 4096 ids at a time. Levels
+		// end at a barrier whose completion swaps the frontiers and picks the next direction.
+		template<typename N, typename E>
+		class parallel_bfs {
+		public:
+			using node_id = typename graph_view<N, E>::node_id;
+			static constexpr node_id no_node = graph_view<N, E>::no_node;
+
+			// Searches until every node reachable from source is found, or target is if it is not
+			// no_node. Uses up to threads threads, the calling one included; 0 means one per core.
+			parallel_bfs(graph_view<N, E> view, node_id source, node_id target, std::size_t threads);
+
+			// Id of the node each id was reached from, source for the source, no_node if not reached
+			std::vector<node_id> parents;
+			// Hops from the source to each node reached
+			std::vector<std::uint32_t> hops;
+
+		private:
+			// Beamer et al.'s thresholds: go bottom-up once the frontier's out-edges exceed 1/14 of
+			// the unexplored edges, and back top-down once it holds under 1/24 of the nodes.
+			static constexpr std::size_t bottom_up_divisor = 14;
+			static constexpr std::size_t top_down_divisor = 24;
+			static constexpr std::size_t chunk_words = 64;
+
+			graph_view<N, E> view_;
+			node_id target_;
+			std::vector<std::uint64_t> frontier_;
+			std::vector<std::uint64_t> next_;
+			std::size_t chunks_;
+			std::atomic<std::size_t> next_chunk_{0};
+			std::atomic<std::size_t> next_nodes_{0};
+			std::atomic<std::size_t> next_edges_{0};
+			std::atomic<bool> found_{false};
+			// Changed only between levels
+			std::uint32_t depth_ = 0;
+			std::size_t frontier_nodes_ = 1;
+			std::size_t frontier_edges_ = 0;
+			std::size_t unexplored_edges_ = 0;
+			bool bottom_up_ = false;
+			bool done_ = false;
+
+			auto step() -> void;
+			auto top_down(std::size_t first_word, std::size_t last_word)
+			   -> std::pair<std::size_t, std::size_t>;
+			auto bottom_up(std::size_t first_word, std::size_t last_word)
+			   -> std::pair<std::size_t, std::size_t>
+			requires graph_view<N, E>::has_sources;
+			auto end_level() noexcept -> void;
+		};
+
+		template<typename N, typename E>
+		parallel_bfs<N, E>::parallel_bfs(graph_view<N, E> const view,
+		                                 node_id const source,
+		                                 node_id const target,
+		                                 std::size_t threads)
+		: parents(view.id_limit(), no_node)
+		, hops(view.id_limit(), 0)
+		, view_{view}
+		, target_{target}
+		, frontier_((view.id_limit() + 63) / 64, 0)
+		, next_(frontier_.size(), 0)
+		, chunks_{(frontier_.size() + chunk_words - 1) / chunk_words} {
+			parents[source] = source;
+			frontier_[source / 64] = std::uint64_t{1} << (source % 64);
+			frontier_edges_ = view.out_edges(source).size();
+			for (auto const id : view.ids()) {
+				unexplored_edges_ += view.out_edges(id).size();
+			}
+			unexplored_edges_ -= frontier_edges_;
+			done_ = source == target;
+			if (done_) {
+				return;
+			}
+
+			if (threads == 0) {
+				threads = std::max(std::thread::hardware_concurrency(), 1U);
+			}
+			threads = std::min(threads, chunks_);
+			auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), [this]() noexcept {
+				end_level();
+			});
+			auto const work = [this, &sync] {
+				do {
+					step();
+					sync.arrive_and_wait();
+				} while (!done_);
+			};
+			auto workers = std::vector<std::jthread>{};
+			workers.reserve(threads - 1);
+			for (auto i = std::size_t{1}; i < threads; ++i) {
+				try {
+					workers.emplace_back(work);
+				}
+				catch (std::system_error const&) {
+					// Carry on with the threads there are.
+					for (; i < threads; ++i) {
+						sync.arrive_and_drop();
+					}
+				}
+			}
+			work();
+		}
+
+		template<typename N, typename E>
+		auto parallel_bfs<N, E>::step() -> void {
+			auto nodes = std::size_t{0};
+			auto edges = std::size_t{0};
+			for (auto chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed); chunk < chunks_;
+			     chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed))
+			{
+				auto const first = chunk * chunk_words;
+				auto const last = std::min(first + chunk_words, frontier_.size());
+				auto const [found_nodes, found_edges] = [&] {
+					if constexpr (graph_view<N, E>::has_sources) {
+						if (bottom_up_) {
+							return bottom_up(first, last);
+						}
+					}
+					return top_down(first, last);
+				}();
+				nodes += found_nodes;
+				edges += found_edges;
+			}
+			next_nodes_.fetch_add(nodes, std::memory_order_relaxed);
+			next_edges_.fetch_add(edges, std::memory_order_relaxed);
+		}
+
+		// Claims the unvisited out-neighbours of the frontier nodes in words [first_word,
+		// last_word). Returns how many nodes were claimed and how many out-edges they have.
+		template<typename N, typename E>
+		auto parallel_bfs<N, E>::top_down(std::size_t const first_word, std::size_t const last_word)
+		   -> std::pair<std::size_t, std::size_t> {
+			auto nodes = std::size_t{0};
+			auto edges = std::size_t{0};
+			for (auto word = first_word; word < last_word; ++word) {
+				for (auto bits = frontier_[word]; bits != 0; bits &= bits - 1) {
+					auto const bit = static_cast<std::size_t>(std::countr_zero(bits));
+					auto const from = static_cast<node_id>(word * 64 + bit);
+					for (auto const& e : view_.out_edges(from)) {
+						auto parent = std::atomic_ref<node_id>(parents[e.to]);
+						auto expected = no_node;
+						if (parent.load(std::memory_order_relaxed) != no_node
+						    || !parent.compare_exchange_strong(expected,
+						                                       from,
+						                                       std::memory_order_relaxed))
+						{
+							continue;
+						}
+						hops[e.to] = depth_ + 1;
+						std::atomic_ref<std::uint64_t>(next_[e.to / 64])
+						   .fetch_or(std::uint64_t{1} << (e.to % 64), std::memory_order_relaxed);
+						++nodes;
+						edges += view_.out_edges(e.to).size();
+						if (e.to == target_) {
+							found_.store(true, std::memory_order_relaxed);
+						}
+					}
+				}
+			}
+			return {nodes, edges};
+		}
+
+		// Finds a frontier parent for each unvisited node in words [first_word, last_word), which
+		// only this thread touches.
+		template<typename N, typename E>
+		auto parallel_bfs<N, E>::bottom_up(std::size_t const first_word, std::size_t const last_word)
+		   -> std::pair<std::size_t, std::size_t>
+		requires graph_view<N, E>::has_sources
+		{
+			auto nodes = std::size_t{0};
+			auto edges = std::size_t{0};
+			auto const limit = parents.size();
+			for (auto word = first_word; word < last_word; ++word) {
+				auto found = std::uint64_t{0};
+				for (auto bit = std::size_t{0}; bit < 64 && word * 64 + bit < limit; ++bit) {
+					auto const to = static_cast<node_id>(word * 64 + bit);
+					if (parents[to] != no_node) {
+						continue;
+					}
+					for (auto const from : view_.sources(to)) {
+						if ((frontier_[from / 64] >> (from % 64) & 1U) != 0) {
+							parents[to] = from;
+							hops[to] = depth_ + 1;
+							found |= std::uint64_t{1} << bit;
+							++nodes;
+							edges += view_.out_edges(to).size();
+							if (to == target_) {
+								found_.store(true, std::memory_order_relaxed);
+							}
+							break;
+						}
+					}
+				}
+				next_[word] = found;
+			}
+			return {nodes, edges};
+		}
+
+		template<typename N, typename E>
+		auto parallel_bfs<N, E>::end_level() noexcept -> void {
+			++depth_;
+			frontier_nodes_ = next_nodes_.exchange(0, std::memory_order_relaxed);
+			frontier_edges_ = next_edges_.exchange(0, std::memory_order_relaxed);
+			unexplored_edges_ -= frontier_edges_;
+			next_chunk_.store(0, std::memory_order_relaxed);
+			std::swap(frontier_, next_);
+			std::fill(next_.begin(), next_.end(), 0);
+			done_ = frontier_nodes_ == 0 || found_.load(std::memory_order_relaxed);
+			if constexpr (graph_view<N, E>::has_sources) {
+				if (!bottom_up_) {
+					bottom_up_ = frontier_edges_ > unexplored_edges_ / bottom_up_divisor;
+				}
+				else {
+					bottom_up_ = frontier_nodes_ >= view_.ids().size() / top_down_divisor;
+				}
+			}
+		}
+	} // namespace detail
+
+	// Hop counts from one node to every other in a graph<N, E>, ignoring weights, and the node
+	// each was first reached from. Built by bfs; independent of the graph once built.
+	template<typename N>
+	class bfs_tree {
+	public:
+		// Searches g from src with up to threads threads, 0 meaning one per core. Throws if src is
+		// not a node.
+		template<typename E>
+		bfs_tree(graph<N, E> const& g, N const& src, std::size_t threads = 0);
+
+		[[nodiscard]] auto source() const -> N const& {
+			return tree_.nodes[tree_.source];
+		}
+		// The following throw if dst is not a node of the graph
+		[[nodiscard]] auto is_reachable(N const& dst) const -> bool {
+			return tree_.reached(tree_.index_of(dst, "gdwg::bfs_tree<N>::is_reachable"));
+		}
+		// Fewest edges on a path from source() to dst, or nothing if there is no path
+		[[nodiscard]] auto hops(N const& dst) const -> std::optional<std::size_t> {
+			auto const i = tree_.index_of(dst, "gdwg::bfs_tree<N>::hops");
+			return tree_.reached(i) ? std::optional<std::size_t>(hops_[i]) : std::nullopt;
+		}
+		// Node dst was reached from, or nothing for source() itself and nodes that cannot be
+		// reached
+		[[nodiscard]] auto parent(N const& dst) const -> std::optional<N> {
+			return tree_.parent(tree_.index_of(dst, "gdwg::bfs_tree<N>::parent"));
+		}
+		// Nodes of a path with fewest edges from source() to dst, or empty if there is none
+		[[nodiscard]] auto path_to(N const& dst) const -> std::vector<N> {
+			return tree_.path_to(tree_.index_of(dst, "gdwg::bfs_tree<N>::path_to"));
+		}
+
+	private:
+		detail::search_tree<N> tree_{};
+		std::vector<std::uint32_t> hops_{};
+	};
+
+	// Breadth-first search of g from src; see bfs_tree and detail::parallel_bfs.
+	template<typename N, typename E>
+	auto bfs(graph<N, E> const& g, N const& src, std::size_t const threads = 0) -> bfs_tree<N> {
+		return bfs_tree<N>(g, src, threads);
+	}
+
+	// Whether there is a path of any length from src to dst. Searches breadth-first like bfs, but
+	// stops once dst is found. Throws if src or dst is not a node.
+	template<typename N, typename E>
+	auto reachable(graph<N, E> const& g, N const& src, N const& dst, std::size_t const threads = 0)
+	   -> bool {
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const from = view.locate(src);
+		auto const to = view.locate(dst);
+		if (from == view.no_node || to == view.no_node) {
+			throw std::runtime_error("Cannot call gdwg::reachable if src or dst node don't exist in "
+			                         "the graph");
+		}
+		return detail::parallel_bfs<N, E>(view, from, to, threads).parents[to] != view.no_node;
+	}
+
+	template<typename N>
+	template<typename E>
+	bfs_tree<N>::bfs_tree(graph<N, E> const& g, N const& src, std::size_t const threads) {
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const source = view.locate(src);
+		if (source == view.no_node) {
+			throw std::runtime_error("Cannot call gdwg::bfs if src doesn't exist in the graph");
+		}
+		auto const search = detail::parallel_bfs<N, E>(view, source, view.no_node, threads);
+		auto const& ids = view.ids();
+		auto positions = std::vector<std::uint32_t>(view.id_limit());
+		for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+			positions[ids[i]] = static_cast<std::uint32_t>(i);
+		}
+		tree_.source = positions[source];
+		tree_.nodes.reserve(ids.size());
+		tree_.parents.reserve(ids.size());
+		hops_.reserve(ids.size());
+		for (auto const id : ids) {
+			tree_.nodes.push_back(view.value(id));
+			auto const parent = search.parents[id];
+			tree_.parents.push_back(parent == view.no_node ? tree_.npos : positions[parent]);
+			hops_.push_back(search.hops[id]);
+		}
+	}
+
+	namespace detail {
+		// Strongly connected components by Tarjan's algorithm, with an explicit stack of (node,
+		// next out-edge) frames instead of recursion, so path length is bounded by memory rather
+		// than by the call stack. O(V + E).
+		template<typename N, typename E>
+		struct tarjan {
+			using node_id = typename graph_view<N, E>::node_id;
+			static constexpr std::uint32_t unvisited = std::numeric_limits<std::uint32_t>::max();
+
+			explicit tarjan(graph_view<N, E> view);
+
+			// Component of each node id, numbered so that every edge between two components goes
+			// from the lower number to the higher
+			std::vector<std::uint32_t> components;
+			std::uint32_t count = 0;
+		};
+
+		template<typename N, typename E>
+		tarjan<N, E>::tarjan(graph_view<N, E> const view)
+		: components(view.id_limit(), unvisited) {
+			struct frame {
+				node_id node;
+				std::uint32_t next_edge;
+			};
+			auto order = std::vector<std::uint32_t>(view.id_limit(), unvisited);
+			auto low = std::vector<std::uint32_t>(view.id_limit());
+			// Nodes visited but not yet assigned a component, the ones with components[id] still
+			// unvisited and order[id] set
+			auto open = std::vector<node_id>{};
+			auto frames = std::vector<frame>{};
+			auto visited = std::uint32_t{0};
+			auto const visit = [&](node_id const id) {
+				order[id] = low[id] = visited++;
+				open.push_back(id);
+				frames.push_back({id, 0});
+			};
+
+			// Components complete sinks first, so they are numbered down from the top.
+			auto found = std::uint32_t{0};
+			for (auto const root : view.ids()) {
+				if (order[root] != unvisited) {
+					continue;
+				}
+				visit(root);
+				while (!frames.empty()) {
+					auto const id = frames.back().node;
+					auto const& out = view.out_edges(id);
+					if (frames.back().next_edge < out.size()) {
+						auto const to = out[frames.back().next_edge++].to;
+						if (order[to] == unvisited) {
+							visit(to);
+						}
+						else if (components[to] == unvisited) {
+							low[id] = std::min(low[id], order[to]);
+						}
+						continue;
+					}
+					frames.pop_back();
+					if (!frames.empty()) {
+						auto const parent = frames.back().node;
+						low[parent] = std::min(low[parent], low[id]);
+					}
+					if (low[id] == order[id]) {
+						auto member = node_id{};
+						do {
+							member = open.back();
+							open.pop_back();
+							components[member] = found;
+						} while (member != id);
+						++found;
+					}
+				}
+			}
+			count = found;
+			for (auto const id : view.ids()) {
+				components[id] = count - 1 - components[id];
+			}
+		}
+	} // namespace detail
+
+	// The nodes of a graph<N, E> split into components numbered from 0, as found by
+	// strongly_connected_components or weakly_connected_components. Independent of the graph once
+	// built.
+	template<typename N>
+	class component_map {
+	public:
+		// nodes sorted, with components[i] the component of nodes[i], each below count and none
+		// left empty
+		component_map(std::vector<N> nodes, std::vector<std::uint32_t> components, std::size_t count);
+
+		// Number of components
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return offsets_.size() - 1;
+		}
+		// Component holding value. Throws if value is not a node of the graph.
+		[[nodiscard]] auto component_of(N const& value) const -> std::size_t;
+		// Nodes of a component in ascending order. Throws if there is no such component.
+		[[nodiscard]] auto members(std::size_t component) const -> std::vector<N>;
+
+	private:
+		// Every node, sorted
+		std::vector<N> nodes_{};
+		// Component of each node in nodes_
+		std::vector<std::uint32_t> components_{};
+		// Positions in nodes_ of each component's members, component by component;
+		// offsets_[c]..offsets_[c + 1] are those of component c
+		std::vector<std::uint32_t> members_{};
+		std::vector<std::size_t> offsets_;
+	};
+
+	// The strongly connected components of g, the largest sets of nodes that can all reach each
+	// other, in O(V + E). Components are numbered in topological order, so every edge between two
+	// components goes from the lower number to the higher.
+	template<typename N, typename E>
+	auto strongly_connected_components(graph<N, E> const& g) -> component_map<N> {
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const scc = detail::tarjan<N, E>(view);
+		auto const& ids = view.ids();
+		auto nodes = std::vector<N>{};
+		auto components = std::vector<std::uint32_t>{};
+		nodes.reserve(ids.size());
+		components.reserve(ids.size());
+		for (auto const id : ids) {
+			nodes.push_back(view.value(id));
+			components.push_back(scc.components[id]);
+		}
+		return component_map<N>(std::move(nodes), std::move(components), scc.count);
+	}
+
+	// The condensation of g: a node for each strongly connected component, numbered as by
+	// strongly_connected_components, and an edge from one component to another weighted by the
+	// number of g's edges between them. Always acyclic.
+	template<typename N, typename E>
+	auto condensation(graph<N, E> const& g) -> graph<std::size_t, std::size_t> {
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const scc = detail::tarjan<N, E>(view);
+		auto links = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+		for (auto const id : view.ids()) {
+			for (auto const& e : view.out_edges(id)) {
+				if (scc.components[id] != scc.components[e.to]) {
+					links.emplace_back(scc.components[id], scc.components[e.to]);
+				}
+			}
+		}
+		std::sort(links.begin(), links.end());
+
+		auto nodes = std::vector<std::size_t>(scc.count);
+		for (auto c = std::size_t{0}; c < nodes.size(); ++c) {
+			nodes[c] = c;
+		}
+		auto edges = std::vector<graph<std::size_t, std::size_t>::value_type>{};
+		for (auto first = links.begin(); first != links.end();) {
+			auto const last = std::find_if(first, links.end(), [&](auto const& link) {
+				return link != *first;
+			});
+			edges.emplace_back(first->first, first->second, static_cast<std::size_t>(last - first));
+			first = last;
+		}
+		auto result = graph<std::size_t, std::size_t>(nodes.begin(), nodes.end());
+		result.insert_edges(edges.begin(), edges.end());
+		return result;
+	}
+
+	// Every node of g, ordered so that each edge goes from an earlier node to a later one. Throws
+	// if g has a cycle, a self-loop included. O(V + E).
+	template<typename N, typename E>
+	auto topological_order(graph<N, E> const& g) -> std::vector<N> {
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const scc = detail::tarjan<N, E>(view);
+		auto const& ids = view.ids();
+		auto const self_loop = [&](auto const id) {
+			auto const& out = view.out_edges(id);
+			return std::any_of(out.begin(), out.end(), [id](auto const& e) { return e.to == id; });
+		};
+		if (scc.count != ids.size() || std::any_of(ids.begin(), ids.end(), self_loop)) {
+			throw std::runtime_error("Cannot call gdwg::topological_order on a graph with a cycle");
+		}
+		// Each component is one node, so the component numbers are the order.
+		auto order = std::vector<typename detail::graph_view<N, E>::node_id>(ids.size());
+		for (auto const id : ids) {
+			order[scc.components[id]] = id;
+		}
+		auto result = std::vector<N>{};
+		result.reserve(order.size());
+		for (auto const id : order) {
+			result.push_back(view.value(id));
+		}
+		return result;
+	}
+
+	template<typename N>
+	component_map<N>::component_map(std::vector<N> nodes,
+	                                 std::vector<std::uint32_t> components,
+	                                 std::size_t const count)
+	: nodes_(std::move(nodes))
+	, components_(std::move(components))
+	, offsets_(count + 1, 0) {
+		for (auto const c : components_) {
+			++offsets_[c + std::size_t{1}];
+		}
+		for (auto c = std::size_t{1}; c < offsets_.size(); ++c) {
+			offsets_[c] += offsets_[c - 1];
+		}
+		// Counting sort by component; positions stay ascending within each.
+		members_.resize(components_.size());
+		auto next = std::vector<std::size_t>(offsets_.begin(), offsets_.end() - 1);
+		for (auto i = std::size_t{0}; i < components_.size(); ++i) {
+			members_[next[components_[i]]++] = static_cast<std::uint32_t>(i);
+		}
+	}
+
+	template<typename N>
+	auto component_map<N>::component_of(N const& value) const -> std::size_t {
+		auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+		if (it == nodes_.end() || !(*it == value)) {
+			throw std::runtime_error("Cannot call gdwg::component_map<N>::component_of if value "
+			                         "doesn't exist in the graph");
+		}
+		return components_[static_cast<std::size_t>(it - nodes_.begin())];
+	}
+
+	template<typename N>
+	auto component_map<N>::members(std::size_t const component) const -> std::vector<N> {
+		if (component >= size()) {
+			throw std::runtime_error("Cannot call gdwg::component_map<N>::members on a component "
+			                         "that doesn't exist");
+		}
+		auto result = std::vector<N>{};
+		result.reserve(offsets_[component + 1] - offsets_[component]);
+		for (auto i = offsets_[component]; i < offsets_[component + 1]; ++i) {
+			result.push_back(nodes_[members_[i]]);
+		}
+		return result;
+	}
+
+	// Settings for pagerank
+	struct pagerank_options {
+		// Chance of following an out-edge rather than jumping to any node at random
+		double damping = 0.85;
+		// Stop once no more than this much score moves between nodes in an iteration
+		double tolerance = 1e-10;
+		std::size_t max_iterations = 100;
+		// Threads to use, the calling one included; 0 means one per core
+		std::size_t threads = 0;
+	};
+
+	namespace detail {
+		// The transpose of a graph's adjacency matrix, compressed by rows over node indices
+		// (positions in sorted order): for each node, the sources of its in-edges, one per edge. The
+		// layout pull kernels read.
+		template<typename N, typename E>
+		struct incoming {
+			using index_type = std::uint32_t;
+
+			explicit incoming(graph_view<N, E> of);
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return out_degrees.size();
+			}
+
+			// sources[offsets[i]..offsets[i + 1]) are the sources of node i's in-edges
+			std::vector<std::size_t> offsets;
+			std::vector<index_type> sources{};
+			std::vector<std::uint32_t> out_degrees{};
+		};
+
+		template<typename N, typename E>
+		incoming<N, E>::incoming(graph_view<N, E> const of)
+		: offsets(of.ids().size() + 1, 0) {
+			auto const& ids = of.ids();
+			auto positions = std::vector<index_type>(of.id_limit());
+			out_degrees.reserve(ids.size());
+			for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+				positions[ids[i]] = static_cast<index_type>(i);
+				out_degrees.push_back(static_cast<std::uint32_t>(of.out_edges(ids[i]).size()));
+			}
+			for (auto const id : ids) {
+				for (auto const& e : of.out_edges(id)) {
+					++offsets[positions[e.to] + std::size_t{1}];
+				}
+			}
+			for (auto i = std::size_t{1}; i < offsets.size(); ++i) {
+				offsets[i] += offsets[i - 1];
+			}
+			sources.resize(offsets.back());
+			auto next = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+			for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+				for (auto const& e : of.out_edges(ids[i])) {
+					sources[next[positions[e.to]]++] = static_cast<index_type>(i);
+				}
+			}
+		}
+
+		// The pull kernel: the sum of x over the sources of node i's in-edges, one row of the
+		// transposed matrix times x. Four partial sums keep the additions from waiting on each other
+		// and leave the loop free to vectorise; the result can differ from a sum in edge order in the
+		// last bits.
+		template<typename N, typename E>
+		auto pull(incoming<N, E> const& m, double const* const x, std::size_t const i) -> double {
+			auto const* const sources = m.sources.data();
+			auto const first = m.offsets[i];
+			auto const last = m.offsets[i + 1];
+			auto const end4 = first + (last - first) / 4 * 4;
+			auto sums = std::array<double, 4>{};
+			for (auto k = first; k < end4; k += 4) {
+				sums[0] += x[sources[k]];
+				sums[1] += x[sources[k + 1]];
+				sums[2] += x[sources[k + 2]];
+				sums[3] += x[sources[k + 3]];
+			}
+			for (auto k = end4; k < last; ++k) {
+				sums[0] += x[sources[k]];
+			}
+			return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+		}
+
+		// PageRank by power iteration over the transposed matrix, pulling each node's new score from
+		// the shares of its sources so that each thread writes only its own nodes. Threads take
+		// fixed ranges of nodes with about as many nodes plus in-edges each, and iterations end at a
+		// barrier whose completion totals the per-thread sums and checks for convergence. Nodes
+		// without out-edges share their score evenly among every node.
+		template<typename N, typename E>
+		class parallel_pagerank {
+		public:
+			parallel_pagerank(incoming<N, E> const& m, pagerank_options const& options);
+
+			// Score of each node index
+			std::vector<double> scores;
+			std::size_t iterations = 0;
+			bool converged = false;
+
+		private:
+			static constexpr std::size_t min_nodes_per_thread = 4096;
+
+			// Each thread's sums for the iteration, a cache line apiece
+			struct alignas(64) partial {
+				double change = 0;
+				double dangling = 0;
+			};
+
+			incoming<N, E> const& m_;
+			pagerank_options options_;
+			// Score of each node divided by its out-degree, read by pull, for this iteration and the
+			// next
+			std::vector<double> shares_;
+			std::vector<double> next_shares_;
+			std::vector<double> next_scores_;
+			std::vector<partial> partials_{};
+			// Score every node gets from random jumps and nodes without out-edges this iteration
+			double base_ = 0;
+			bool done_ = false;
+
+			auto step(std::size_t first, std::size_t last, partial& sums) -> void;
+			auto end_iteration() noexcept -> void;
+		};
+
+		template<typename N, typename E>
+		parallel_pagerank<N, E>::parallel_pagerank(incoming<N, E> const& m,
+		                                           pagerank_options const& options)
+		: scores(m.size(), 1.0 / static_cast<double>(m.size()))
+		, m_{m}
+		, options_{options}
+		, shares_(m.size())
+		, next_shares_(m.size())
+		, next_scores_(m.size()) {
+			auto const n = m.size();
+			auto dangling = 0.0;
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				if (m.out_degrees[i] == 0) {
+					dangling += scores[i];
+				}
+				else {
+					shares_[i] = scores[i] / m.out_degrees[i];
+				}
+			}
+			base_ = ((1 - options_.damping) + options_.damping * dangling) / static_cast<double>(n);
+			done_ = options_.max_iterations == 0;
+			if (done_) {
+				return;
+			}
+
+			auto threads = options_.threads;
+			if (threads == 0) {
+				threads = std::max(std::thread::hardware_concurrency(), 1U);
+			}
+			threads = std::min(threads, (n + min_nodes_per_thread - 1) / min_nodes_per_thread);
+			partials_.resize(threads);
+			// Range boundaries: node i carries a cost of 1 plus its in-edges.
+			auto bounds = std::vector<std::size_t>(threads + 1, n);
+			bounds[0] = 0;
+			auto const total = n + m.offsets.back();
+			for (auto t = std::size_t{1}; t < threads; ++t) {
+				auto const goal = total / threads * t;
+				auto first = bounds[t - 1];
+				auto last = n;
+				while (first < last) {
+					auto const mid = first + (last - first) / 2;
+					if (mid + m.offsets[mid] < goal) {
+						first = mid + 1;
+					}
+					else {
+						last = mid;
+					}
+				}
+				bounds[t] = first;
+			}
+
+			auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), [this]() noexcept {
+				end_iteration();
+			});
+			// Nodes from here on belong to threads that could not be started, and fall to this one.
+			auto orphans = n;
+			auto const work = [this, &sync, &bounds, &orphans](std::size_t const t) {
+				do {
+					step(bounds[t], bounds[t + 1], partials_[t]);
+					if (t == 0) {
+						step(orphans, m_.size(), partials_[t]);
+					}
+					sync.arrive_and_wait();
+				} while (!done_);
+			};
+			auto workers = std::vector<std::jthread>{};
+			workers.reserve(threads - 1);
+			for (auto t = std::size_t{1}; t < threads; ++t) {
+				try {
+					workers.emplace_back(work, t);
+				}
+				catch (std::system_error const&) {
+					orphans = bounds[t];
+					for (; t < threads; ++t) {
+						sync.arrive_and_drop();
+					}
+				}
+			}
+			work(0);
+		}
+
+		template<typename N, typename E>
+		auto parallel_pagerank<N, E>::step(std::size_t const first,
+		                                   std::size_t const last,
+		                                   partial& sums) -> void {
+			auto const damping = options_.damping;
+			auto change = 0.0;
+			auto dangling = 0.0;
+			for (auto i = first; i < last; ++i) {
+				auto const score = base_ + damping * pull(m_, shares_.data(), i);
+				change += std::abs(score - scores[i]);
+				next_scores_[i] = score;
+				auto const degree = m_.out_degrees[i];
+				if (degree == 0) {
+					dangling += score;
+					next_shares_[i] = 0;
+				}
+				else {
+					next_shares_[i] = score / degree;
+				}
+			}
+			sums.change += change;
+			sums.dangling += dangling;
+		}
+
+		template<typename N, typename E>
+		auto parallel_pagerank<N, E>::end_iteration() noexcept -> void {
+			auto change = 0.0;
+			auto dangling = 0.0;
+			for (auto& sums : partials_) {
+				change += sums.change;
+				dangling += sums.dangling;
+				sums = partial{};
+			}
+			std::swap(scores, next_scores_);
+			std::swap(shares_, next_shares_);
+			base_ = ((1 - options_.damping) + options_.damping * dangling)
+			        / static_cast<double>(m_.size());
+			++iterations;
+			converged = change <= options_.tolerance;
+			done_ = converged || iterations == options_.max_iterations;
+		}
+	} // namespace detail
+
+	// PageRank scores of every node of a graph<N, E>, summing to 1: the share of time a walk spends
+	// at each node if it follows a random out-edge with probability damping, and otherwise, or
+	// where there is no out-edge, jumps to any node. Each edge is one link whatever its weight, so
+	// parallel edges count once each. Built by pagerank; independent of the graph once built.
+	template<typename N>
+	class pagerank_scores {
+	public:
+		template<typename E>
+		pagerank_scores(graph<N, E> const& g, pagerank_options const& options);
+
+		// Throws if value is not a node of the graph
+		[[nodiscard]] auto score(N const& value) const -> double;
+		// Iterations run
+		[[nodiscard]] auto iterations() const noexcept -> std::size_t {
+			return iterations_;
+		}
+		// Whether the scores settled within the tolerance before max_iterations ran out
+		[[nodiscard]] auto converged() const noexcept -> bool {
+			return converged_;
+		}
+
+	private:
+		// Every node, sorted, and its score
+		std::vector<N> nodes_{};
+		std::vector<double> scores_{};
+		std::size_t iterations_ = 0;
+		bool converged_ = true;
+	};
+
+	// PageRank of g; see pagerank_scores and detail::parallel_pagerank. Throws if the damping is
+	// not within [0, 1].
+	template<typename N, typename E>
+	auto pagerank(graph<N, E> const& g, pagerank_options const& options = {})
+	   -> pagerank_scores<N> {
+		return pagerank_scores<N>(g, options);
+	}
+
+	template<typename N>
+	template<typename E>
+	pagerank_scores<N>::pagerank_scores(graph<N, E> const& g, pagerank_options const& options) {
+		if (!(options.damping >= 0 && options.damping <= 1)) {
+			throw std::runtime_error("Cannot call gdwg::pagerank with a damping outside [0, 1]");
+		}
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const& ids = view.ids();
+		if (ids.empty()) {
+			return;
+		}
+		auto const m = detail::incoming<N, E>(view);
+		auto ranks = detail::parallel_pagerank<N, E>(m, options);
+		nodes_.reserve(ids.size());
+		for (auto const id : ids) {
+			nodes_.push_back(view.value(id));
+		}
+		scores_ = std::move(ranks.scores);
+		iterations_ = ranks.iterations;
+		converged_ = ranks.converged;
+	}
+
+	template<typename N>
+	auto pagerank_scores<N>::score(N const& value) const -> double {
+		auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+		if (it == nodes_.end() || !(*it == value)) {
+			throw std::runtime_error("Cannot call gdwg::pagerank_scores<N>::score if value doesn't "
+			                         "exist in the graph");
+		}
+		return scores_[static_cast<std::size_t>(it - nodes_.begin())];
+	}
+
+	namespace detail {
+		// Disjoint sets of the integers [0, size) under union by rank, with find compressing the
+		// path it takes
+		class disjoint_sets {
+		public:
+			explicit disjoint_sets(std::size_t const size)
+			: parents_(size)
+			, ranks_(size, 0) {
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					parents_[i] = static_cast<std::uint32_t>(i);
+				}
+			}
+
+			auto find(std::uint32_t x) -> std::uint32_t {
+				auto root = x;
+				while (parents_[root] != root) {
+					root = parents_[root];
+				}
+				while (parents_[x] != root) {
+					x = std::exchange(parents_[x], root);
+				}
+				return root;
+			}
+			// As find, but leaving the sets as they are, for threads to share
+			[[nodiscard]] auto root_of(std::uint32_t x) const -> std::uint32_t {
+				while (parents_[x] != x) {
+					x = parents_[x];
+				}
+				return x;
+			}
+			// Merges the sets holding a and b. Returns false if they were already one.
+			auto unite(std::uint32_t a, std::uint32_t b) -> bool {
+				a = find(a);
+				b = find(b);
+				if (a == b) {
+					return false;
+				}
+				if (ranks_[a] < ranks_[b]) {
+					std::swap(a, b);
+				}
+				parents_[b] = a;
+				if (ranks_[a] == ranks_[b]) {
+					++ranks_[a];
+				}
+				return true;
+			}
+
+		private:
+			std::vector<std::uint32_t> parents_;
+			std::vector<std::uint8_t> ranks_;
+		};
+
+		// Every edge of a graph but its self-loops in (from, to, weight) order, endpoints as node
+		// indices, for spanning forests. Edges are ranked by weight, and equal weights by index, so
+		// that no two tie.
+		template<typename N, typename E>
+		struct edge_array {
+			explicit edge_array(graph_view<N, E> of);
+
+			[[nodiscard]] auto lighter(std::uint32_t const a, std::uint32_t const b) const -> bool {
+				return weights[a] < weights[b] || (!(weights[b] < weights[a]) && a < b);
+			}
+			[[nodiscard]] auto value(std::uint32_t const e) const -> typename graph<N, E>::value_type {
+				auto const& ids = view.ids();
+				return {view.value(ids[from[e]]), view.value(ids[to[e]]), weights[e]};
+			}
+
+			graph_view<N, E> view;
+			std::vector<std::uint32_t> from{};
+			std::vector<std::uint32_t> to{};
+			std::vector<E> weights{};
+		};
+
+		template<typename N, typename E>
+		edge_array<N, E>::edge_array(graph_view<N, E> const of)
+		: view{of} {
+			auto const& ids = view.ids();
+			auto positions = std::vector<std::uint32_t>(view.id_limit());
+			auto edges = std::size_t{0};
+			for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+				positions[ids[i]] = static_cast<std::uint32_t>(i);
+				edges += view.out_edges(ids[i]).size();
+			}
+			from.reserve(edges);
+			to.reserve(edges);
+			weights.reserve(edges);
+			for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+				for (auto const& e : view.out_edges(ids[i])) {
+					if (e.to != ids[i]) {
+						from.push_back(static_cast<std::uint32_t>(i));
+						to.push_back(positions[e.to]);
+						weights.push_back(view.weight(e));
+					}
+				}
+			}
+		}
+
+		// Sorts entries stably by their weight member. Integral weights are radix sorted a byte at a
+		// time from the lowest, skipping bytes that every weight shares, so small weights take a
+		// pass or two over the entries rather than O(n log n) comparisons.
+		template<typename Entry>
+		auto sort_by_weight(std::vector<Entry>& entries) -> void {
+			using weight_type = decltype(Entry::weight);
+			if constexpr (std::integral<weight_type> && !std::same_as<weight_type, bool>) {
+				using key_type = std::make_unsigned_t<weight_type>;
+				constexpr auto bits = std::numeric_limits<key_type>::digits;
+				// Flipping the sign bit orders signed weights as unsigned keys.
+				constexpr auto flip = std::is_signed_v<weight_type>
+				                         ? static_cast<key_type>(key_type{1} << (bits - 1))
+				                         : key_type{0};
+				auto const digit = [](Entry const& entry, int const shift) {
+					auto const key = static_cast<key_type>(static_cast<key_type>(entry.weight) ^ flip);
+					return static_cast<std::size_t>(key >> shift & 0xFFU);
+				};
+				auto sorted = std::vector<Entry>(entries.size());
+				for (auto shift = 0; shift < bits; shift += 8) {
+					auto starts = std::array<std::size_t, 257>{};
+					for (auto const& entry : entries) {
+						++starts[digit(entry, shift) + 1];
+					}
+					if (std::find(starts.begin(), starts.end(), entries.size()) != starts.end()) {
+						continue;
+					}
+					for (auto d = std::size_t{1}; d < starts.size(); ++d) {
+						starts[d] += starts[d - 1];
+					}
+					for (auto const& entry : entries) {
+						sorted[starts[digit(entry, shift)]++] = entry;
+					}
+					entries.swap(sorted);
+				}
+			}
+			else {
+				std::stable_sort(entries.begin(), entries.end(), [](auto const& a, auto const& b) {
+					return a.weight < b.weight;
+				});
+			}
+		}
+
+		// Kruskal's algorithm: the edges by rank, each kept if it joins two trees. Returns the
+		// indices of the edges kept, ascending.
+		template<typename N, typename E>
+		auto kruskal(edge_array<N, E> const& edges) -> std::vector<std::uint32_t> {
+			// Sorted stably by weight from index order, which gives rank order. Entries carry their
+			// endpoints so the pass over them reads no edge data out of order.
+			struct entry {
+				E weight;
+				std::uint32_t index;
+				std::uint32_t from;
+				std::uint32_t to;
+			};
+			auto order = std::vector<entry>{};
+			order.reserve(edges.from.size());
+			for (auto e = std::size_t{0}; e < edges.from.size(); ++e) {
+				order.push_back(
+				   {edges.weights[e], static_cast<std::uint32_t>(e), edges.from[e], edges.to[e]});
+			}
+			sort_by_weight(order);
+			auto sets = disjoint_sets(edges.view.ids().size());
+			auto forest = std::vector<std::uint32_t>{};
+			for (auto const& e : order) {
+				if (sets.unite(e.from, e.to)) {
+					forest.push_back(e.index);
+				}
+			}
+			std::sort(forest.begin(), forest.end());
+			return forest;
+		}
+
+		// Borůvka's algorithm shared between threads: each round, every tree picks its lightest edge
+		// to another tree and all of those are added at once, at least halving the number of trees.
+		// Threads each take a fixed share of the edges, dropping the ones inside a tree as they go
+		// and offering the rest to both endpoints' trees by compare-and-swap; the picks are joined
+		// in the completion of a barrier, then the threads relabel their share of the nodes with
+		// their new trees. Ties are broken by edge index, so the result is Kruskal's.
+		template<typename N, typename E>
+		class parallel_boruvka {
+		public:
+			// Uses up to threads threads, the calling one included; 0 means one per core.
+			parallel_boruvka(edge_array<N, E> const& edges, std::size_t threads);
+
+			// Indices of the edges in the forest, ascending
+			std::vector<std::uint32_t> forest{};
+
+		private:
+			static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+			static constexpr std::size_t min_edges_per_thread = 4096;
+
+			edge_array<N, E> const& edges_;
+			disjoint_sets sets_;
+			// Tree of each node as of the start of the round, by its root
+			std::vector<std::uint32_t> trees_;
+			// Lightest edge offered to each root this round
+			std::vector<std::uint32_t> lightest_;
+			// Roots of the trees there are
+			std::vector<std::uint32_t> roots_;
+			// Edges that still join two trees. Thread t keeps its own in
+			// live_[first_[t]..last_[t]).
+			std::vector<std::uint32_t> live_;
+			std::vector<std::size_t> first_{};
+			std::vector<std::size_t> last_{};
+			// Changed only between phases
+			bool relabel_ = false;
+			bool done_ = false;
+
+			auto pick(std::size_t thread) -> void;
+			auto relabel(std::size_t thread) -> void;
+			auto end_phase() noexcept -> void;
+		};
+
+		template<typename N, typename E>
+		parallel_boruvka<N, E>::parallel_boruvka(edge_array<N, E> const& edges, std::size_t threads)
+		: edges_{edges}
+		, sets_(edges.view.ids().size())
+		, trees_(edges.view.ids().size())
+		, lightest_(trees_.size(), none)
+		, roots_(trees_.size())
+		, live_(edges.from.size()) {
+			for (auto i = std::size_t{0}; i < trees_.size(); ++i) {
+				trees_[i] = roots_[i] = static_cast<std::uint32_t>(i);
+			}
+			for (auto e = std::size_t{0}; e < live_.size(); ++e) {
+				live_[e] = static_cast<std::uint32_t>(e);
+			}
+			done_ = live_.empty();
+			if (done_) {
+				return;
+			}
+
+			if (threads == 0) {
+				threads = std::max(std::thread::hardware_concurrency(), 1U);
+			}
+			threads = std::min(threads,
+			                   (live_.size() + min_edges_per_thread - 1) / min_edges_per_thread);
+			for (auto t = std::size_t{0}; t < threads; ++t) {
+				first_.push_back(live_.size() * t / threads);
+				last_.push_back(live_.size() * (t + 1) / threads);
+			}
+
+			auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), [this]() noexcept {
+				end_phase();
+			});
+			// Shares from here on belong to threads that could not be started, and fall to this one.
+			auto orphans = threads;
+			auto const work = [this, &sync, &orphans](std::size_t const t) {
+				auto const run = [this](std::size_t const share) {
+					if (relabel_) {
+						relabel(share);
+					}
+					else {
+						pick(share);
+					}
+				};
+				do {
+					run(t);
+					for (auto share = orphans; t == 0 && share < first_.size(); ++share) {
+						run(share);
+					}
+					sync.arrive_and_wait();
+				} while (!done_);
+			};
+			auto workers = std::vector<std::jthread>{};
+			workers.reserve(threads - 1);
+			for (auto t = std::size_t{1}; t < threads; ++t) {
+				try {
+					workers.emplace_back(work, t);
+				}
+				catch (std::system_error const&) {
+					orphans = t;
+					for (; t < threads; ++t) {
+						sync.arrive_and_drop();
+					}
+				}
+			}
+			work(0);
+		}
+
+		template<typename N, typename E>
+		auto parallel_boruvka<N, E>::pick(std::size_t const thread) -> void {
+			auto const offer = [this](std::uint32_t const tree, std::uint32_t const e) {
+				auto lightest = std::atomic_ref<std::uint32_t>(lightest_[tree]);
+				auto current = lightest.load(std::memory_order_relaxed);
+				while ((current == none || edges_.lighter(e, current))
+				       && !lightest.compare_exchange_weak(current, e, std::memory_order_relaxed))
+				{
+				}
+			};
+			auto kept = first_[thread];
+			for (auto i = first_[thread]; i < last_[thread]; ++i) {
+				auto const e = live_[i];
+				auto const from = trees_[edges_.from[e]];
+				auto const to = trees_[edges_.to[e]];
+				if (from != to) {
+					live_[kept++] = e;
+					offer(from, e);
+					offer(to, e);
+				}
+			}
+			last_[thread] = kept;
+		}
+
+		template<typename N, typename E>
+		auto parallel_boruvka<N, E>::relabel(std::size_t const thread) -> void {
+			auto const threads = first_.size();
+			auto const first = trees_.size() * thread / threads;
+			auto const last = trees_.size() * (thread + 1) / threads;
+			for (auto i = first; i < last; ++i) {
+				trees_[i] = sets_.root_of(static_cast<std::uint32_t>(i));
+			}
+		}
+
+		template<typename N, typename E>
+		auto parallel_boruvka<N, E>::end_phase() noexcept -> void {
+			if (relabel_) {
+				relabel_ = false;
+				return;
+			}
+			auto const before = forest.size();
+			for (auto const root : roots_) {
+				auto const e = std::exchange(lightest_[root], none);
+				if (e != none && sets_.unite(edges_.from[e], edges_.to[e])) {
+					forest.push_back(e);
+				}
+			}
+			std::erase_if(roots_, [this](auto const root) { return sets_.find(root) != root; });
+			relabel_ = true;
+			done_ = forest.size() == before;
+			if (done_) {
+				std::sort(forest.begin(), forest.end());
+			}
+		}
+	} // namespace detail
+
+	// A minimum spanning forest of g, taking its edges as undirected: for each weakly connected
+	// component, a tree of edges joining all its nodes with the least total weight. Of edges of
+	// equal weight the one first in g's (from, to, weight) order is preferred, so the forest does
+	// not depend on the algorithm or threads, and its edges come in that order too. With one thread
+	// runs Kruskal's algorithm; with more, 0 meaning one per core, Borůvka's in parallel (see
+	// detail::parallel_boruvka), which does a few times the work and needs as many cores to win.
+	template<typename N, typename E>
+	auto minimum_spanning_forest(graph<N, E> const& g, std::size_t threads = 1)
+	   -> std::vector<typename graph<N, E>::value_type> {
+		auto const edges = detail::edge_array<N, E>(detail::graph_view<N, E>{&g});
+		if (threads == 0) {
+			threads = std::max(std::thread::hardware_concurrency(), 1U);
+		}
+		auto const forest = threads == 1 ? detail::kruskal(edges)
+		                                 : detail::parallel_boruvka<N, E>(edges, threads).forest;
+		auto result = std::vector<typename graph<N, E>::value_type>{};
+		result.reserve(forest.size());
+		for (auto const e : forest) {
+			result.push_back(edges.value(e));
+		}
+		return result;
+	}
+
+	// The weakly connected components of g, the sets of nodes joined by edges taken as undirected,
+	// in O(V + E α(V)). Components are numbered in order of their least node.
+	template<typename N, typename E>
+	auto weakly_connected_components(graph<N, E> const& g) -> component_map<N> {
+		auto const view = detail::graph_view<N, E>{&g};
+		auto const& ids = view.ids();
+		auto positions = std::vector<std::uint32_t>(view.id_limit());
+		for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+			positions[ids[i]] = static_cast<std::uint32_t>(i);
+		}
+		auto sets = detail::disjoint_sets(ids.size());
+		for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+			for (auto const& e : view.out_edges(ids[i])) {
+				sets.unite(static_cast<std::uint32_t>(i), positions[e.to]);
+			}
+		}
+
+		constexpr auto unnumbered = std::numeric_limits<std::uint32_t>::max();
+		auto numbers = std::vector<std::uint32_t>(ids.size(), unnumbered);
+		auto nodes = std::vector<N>{};
+		auto components = std::vector<std::uint32_t>{};
+		nodes.reserve(ids.size());
+		components.reserve(ids.size());
+		auto count = std::uint32_t{0};
+		for (auto i = std::size_t{0}; i < ids.size(); ++i) {
+			auto& number = numbers[sets.find(static_cast<std::uint32_t>(i))];
+			if (number == unnumbered) {
+				number = count++;
+			}
+			nodes.push_back(view.value(ids[i]));
+			components.push_back(number);
+		}
+		return component_map<N>(std::move(nodes), std::move(components), count);
+	}
+} // namespace gdwg
+
+#endif // GDWG_ALGORITHM_HPP
@@ -0,0 +1,235 @@
+#ifndef GDWG_CONCURRENT_GRAPH_HPP
+#define GDWG_CONCURRENT_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Index of the calling thread's reader counters. Threads are numbered in the order they
+		// first read, so up to concurrent_graph's stripe count of readers never share a counter.
+		inline auto reader_stripe() noexcept -> std::size_t {
+			static auto next = std::atomic<std::size_t>{0};
+			thread_local auto const stripe = next.fetch_add(1, std::memory_order_relaxed);
+			return stripe;
+		}
+	} // namespace detail
+
+	// A graph<N, E> that any number of threads can read while others change it.
+	//
+	// Readers never block: read() pins the current version of the graph and returns a handle to
+	// it. Every change is made to a copy of the current version, which is then published with one
+	// atomic store, so a reader sees either all of a change or none of it. Writers are serialised
+	// by a mutex but never wait for readers.
+	//
+	// Replaced versions are reclaimed with epochs, RCU-style. Each reader counts itself in the
+	// counter for the parity of the epoch it started in. The epoch only moves on once every reader
+	// in the parity it last moved away from has left, so by the time it has moved three times
+	// after a version was replaced, no reader can still be using that version. Writers move the
+	// epoch on as far as they can and free what they can on each change.
+	//
+	// Copying the current version is O(1) when copy_mode_for<N, E> is copy_on_write. Otherwise
+	// each change copies the whole graph, and changes should be batched through update().
+	template<typename N, typename E>
+	class concurrent_graph {
+	public:
+		using graph_type = graph<N, E>;
+
+		// A pinned version of the graph. It stays valid, and unchanged, until the handle is
+		// destroyed, and must not outlive the concurrent_graph it came from. Versions replaced
+		// while a handle is held are only freed after it goes, so keep handles short-lived.
+		class read_handle {
+		public:
+			read_handle(read_handle const&) = delete;
+			auto operator=(read_handle const&) -> read_handle& = delete;
+			~read_handle() {
+				readers_->fetch_sub(1, std::memory_order_release);
+			}
+
+			auto operator*() const noexcept -> graph_type const& {
+				return *graph_;
+			}
+			auto operator->() const noexcept -> graph_type const* {
+				return graph_;
+			}
+
+		private:
+			friend class concurrent_graph;
+			read_handle(graph_type const* g, std::atomic<std::size_t>* readers) noexcept
+			: graph_{g}
+			, readers_{readers} {}
+
+			graph_type const* graph_;
+			std::atomic<std::size_t>* readers_;
+		};
+
+		concurrent_graph()
+		: concurrent_graph(graph_type{}) {}
+		explicit concurrent_graph(graph_type g)
+		: current_{new graph_type(std::move(g))} {}
+		concurrent_graph(concurrent_graph const&) = delete;
+		auto operator=(concurrent_graph const&) -> concurrent_graph& = delete;
+		~concurrent_graph() {
+			delete current_.load(std::memory_order_acquire);
+		}
+
+		// Readers
+		[[nodiscard]] auto read() const -> read_handle;
+		// Copy of the current version
+		[[nodiscard]] auto snapshot() const -> graph_type {
+			return *read();
+		}
+		// Same behaviour and exceptions as their graph<N, E> counterparts, on the current version
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return read()->is_node(value);
+		}
+		[[nodiscard]] auto empty() const -> bool {
+			return read()->empty();
+		}
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			return read()->is_connected(src, dst);
+		}
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return read()->nodes();
+		}
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			return read()->weights(src, dst);
+		}
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			return read()->connections(src);
+		}
+		[[nodiscard]] auto in_connections(N const& dst) const -> std::vector<N> {
+			return read()->in_connections(dst);
+		}
+
+		// Writers
+		// Calls f on a copy of the current version and publishes the copy as one change, returning
+		// what f returns. If f throws, or returns a bool that is false, nothing is published.
+		template<typename F>
+		auto update(F f) -> std::invoke_result_t<F&, graph_type&>;
+		auto insert_node(N const& value) -> bool {
+			return update([&](graph_type& g) { return g.insert_node(value); });
+		}
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			return update([&](graph_type& g) { return g.insert_edge(src, dst, weight); });
+		}
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			return update([&](graph_type& g) { return g.replace_node(old_data, new_data); });
+		}
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			update([&](graph_type& g) { g.merge_replace_node(old_data, new_data); });
+		}
+		auto erase_node(N const& value) -> bool {
+			return update([&](graph_type& g) { return g.erase_node(value); });
+		}
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			return update([&](graph_type& g) { return g.erase_edge(src, dst, weight); });
+		}
+		auto clear() -> void {
+			update([](graph_type& g) { g.clear(); });
+		}
+
+	private:
+		static constexpr std::size_t stripes = 64;
+		// Readers inside each epoch parity, one pair per cache line
+		struct alignas(64) reader_counts {
+			std::array<std::atomic<std::size_t>, 2> count{};
+		};
+
+		// A replaced version and the epoch it was replaced in
+		struct retired_version {
+			std::unique_ptr<graph_type const> graph;
+			std::size_t epoch;
+		};
+
+		std::atomic<graph_type const*> current_;
+		// Only changed by writers, under writer_
+		std::atomic<std::size_t> epoch_{0};
+		mutable std::array<reader_counts, stripes> readers_{};
+		std::mutex writer_{};
+		// Guarded by writer_
+		std::vector<retired_version> retired_{};
+
+		// Replaces the current version with next, retiring the old one
+		auto publish(std::unique_ptr<graph_type const> next) -> void;
+		// Moves the epoch on as far as readers allow and frees the versions no reader can see
+		auto reclaim() -> void;
+		auto readers_in(std::size_t parity) const -> std::size_t;
+	};
+
+	template<typename N, typename E>
+	auto concurrent_graph<N, E>::read() const -> read_handle {
+		auto& counts = readers_[detail::reader_stripe() % stripes].count;
+		auto& readers = counts[epoch_.load() & 1U];
+		readers.fetch_add(1);
+		// Loaded after counting in, so a writer that replaces this version after the load waits
+		// for this reader before freeing it.
+		return read_handle{current_.load(), &readers};
+	}
+
+	template<typename N, typename E>
+	template<typename F>
+	auto concurrent_graph<N, E>::update(F f) -> std::invoke_result_t<F&, graph_type&> {
+		using result_type = std::invoke_result_t<F&, graph_type&>;
+		auto const lock = std::scoped_lock{writer_};
+		// Only writers store current_, so under the lock it cannot change or be freed.
+		auto next = std::make_unique<graph_type>(*current_.load(std::memory_order_relaxed));
+		if constexpr (std::is_void_v<result_type>) {
+			f(*next);
+			publish(std::move(next));
+		}
+		else {
+			auto result = f(*next);
+			if constexpr (std::is_same_v<result_type, bool>) {
+				if (!result) {
+					return result;
+				}
+			}
+			publish(std::move(next));
+			return result;
+		}
+	}
+
+	template<typename N, typename E>
+	auto concurrent_graph<N, E>::publish(std::unique_ptr<graph_type const> next) -> void {
+		auto old = std::unique_ptr<graph_type const>(current_.exchange(next.release()));
+		retired_.push_back(retired_version{std::move(old), epoch_.load()});
+		reclaim();
+	}
+
+	template<typename N, typename E>
+	auto concurrent_graph<N, E>::reclaim() -> void {
+		// A reader holding a version replaced in epoch t counted itself in the parity of t or
+		// earlier before the version was replaced. Moving from t + 1 to t + 2 needs the readers of
+		// t's parity gone, and from t + 2 to t + 3 those of the other parity, so by t + 3 it has
+		// left either way.
+		for (auto step = 0; step < 3; ++step) {
+			auto const epoch = epoch_.load();
+			if (readers_in((epoch + 1) & 1U) != 0) {
+				break;
+			}
+			epoch_.store(epoch + 1);
+		}
+		auto const epoch = epoch_.load();
+		std::erase_if(retired_, [epoch](retired_version const& r) { return epoch >= r.epoch + 3; });
+	}
+
+	template<typename N, typename E>
+	auto concurrent_graph<N, E>::readers_in(std::size_t const parity) const -> std::size_t {
+		auto total = std::size_t{0};
+		for (auto const& counts : readers_) {
+			total += counts.count[parity].load();
+		}
+		return total;
+	}
+} // namespace gdwg
+
+#endif // GDWG_CONCURRENT_GRAPH_HPP
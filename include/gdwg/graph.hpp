@@ -2,22 +2,699 @@
 #define GDWG_GRAPH_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <locale>
 #include <memory>
-#include <set>
-#include <unordered_set>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace gdwg {
 
+	namespace detail {
+		template<typename T>
+		concept hashable = requires(T const& value) {
+			{ std::hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+		};
+
+		// Values addressed by dense 32-bit ids. Erased slots are handed out again by later inserts,
+		// so ids stay small and the values stay in one contiguous block.
+		template<typename T>
+		class arena {
+		public:
+			using id_type = std::uint32_t;
+
+			auto insert(T value) -> id_type {
+				if (free_.empty()) {
+					if (slots_.size() >= std::numeric_limits<id_type>::max()) {
+						throw std::length_error("gdwg::graph cannot hold more than 2^32 - 1 nodes or "
+						                        "weights");
+					}
+					// The free list always has room for every slot, so erase never allocates
+					if (free_.capacity() <= slots_.size()) {
+						free_.reserve(std::max(slots_.size() + 1, 2 * free_.capacity()));
+					}
+					slots_.emplace_back(std::move(value));
+					return static_cast<id_type>(slots_.size() - 1);
+				}
+				auto const id = free_.back();
+				slots_[id].emplace(std::move(value));
+				free_.pop_back();
+				return id;
+			}
+			auto erase(id_type const id) noexcept -> void {
+				slots_[id].reset();
+				free_.push_back(id);
+			}
+			auto operator[](id_type const id) -> T& {
+				return *slots_[id];
+			}
+			auto operator[](id_type const id) const -> T const& {
+				return *slots_[id];
+			}
+			// One past the largest id handed out so far
+			[[nodiscard]] auto id_limit() const noexcept -> std::size_t {
+				return slots_.size();
+			}
+			auto clear() noexcept -> void {
+				slots_.clear();
+				free_.clear();
+			}
+
+		private:
+			std::vector<std::optional<T>> slots_{};
+			std::vector<id_type> free_{};
+		};
+
+		// Open-addressing (linear probing) hash set of 32-bit ids. The table never looks at the
+		// values behind the ids: callers supply the hash and an equality test, so it can index
+		// values stored elsewhere without holding a copy or a pointer to them.
+		class id_table {
+		public:
+			using id_type = std::uint32_t;
+			static constexpr id_type npos = std::numeric_limits<id_type>::max();
+
+			// The id whose value hashes to hash and satisfies equal(id), or npos
+			template<typename Equal>
+			[[nodiscard]] auto find(std::size_t const hash, Equal equal) const -> id_type {
+				if (slots_.empty()) {
+					return npos;
+				}
+				auto const h = fold(hash);
+				for (auto i = home(h); slots_[i].id != npos; i = next(i)) {
+					if (slots_[i].hash == h && equal(slots_[i].id)) {
+						return slots_[i].id;
+					}
+				}
+				return npos;
+			}
+			auto insert(id_type const id, std::size_t const hash) -> void {
+				reserve(size_ + 1);
+				place(slot{id, fold(hash)});
+				++size_;
+			}
+			// Removes id, which must be present, using backward-shift deletion so no tombstones
+			// are left behind.
+			auto erase(id_type const id, std::size_t const hash) -> void {
+				auto i = home(fold(hash));
+				while (slots_[i].id != id) {
+					i = next(i);
+				}
+				for (auto j = next(i); slots_[j].id != npos; j = next(j)) {
+					auto const k = home(slots_[j].hash);
+					auto const stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+					if (!stays) {
+						slots_[i] = slots_[j];
+						i = j;
+					}
+				}
+				slots_[i] = slot{};
+				--size_;
+			}
+			auto reserve(std::size_t const count) -> void {
+				if (count * 4 <= slots_.size() * 3) {
+					return;
+				}
+				auto capacity = std::max(slots_.size(), std::size_t{8});
+				while (count * 4 > capacity * 3) {
+					capacity *= 2;
+				}
+				auto old = std::exchange(slots_, std::vector<slot>(capacity));
+				shift_ = 32;
+				for (auto c = capacity; c > 1; c /= 2) {
+					--shift_;
+				}
+				for (auto const& s : old) {
+					if (s.id != npos) {
+						place(s);
+					}
+				}
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return size_;
+			}
+			auto clear() noexcept -> void {
+				slots_.clear();
+				size_ = 0;
+			}
+
+		private:
+			struct slot {
+				id_type id = npos;
+				std::uint32_t hash = 0;
+			};
+			std::vector<slot> slots_{};
+			std::size_t size_ = 0;
+			int shift_ = 32;
+
+			static auto fold(std::size_t const hash) noexcept -> std::uint32_t {
+				return static_cast<std::uint32_t>(hash ^ (hash >> 32U));
+			}
+			// Fibonacci hashing, so identity hashes such as std::hash<int> still spread out
+			[[nodiscard]] auto home(std::uint32_t const hash) const noexcept -> std::size_t {
+				return static_cast<std::size_t>((hash * std::uint32_t{2654435769U}) >> shift_);
+			}
+			[[nodiscard]] auto next(std::size_t const i) const noexcept -> std::size_t {
+				return (i + 1) & (slots_.size() - 1);
+			}
+			auto place(slot const s) -> void {
+				auto i = home(s.hash);
+				while (slots_[i].id != npos) {
+					i = next(i);
+				}
+				slots_[i] = s;
+			}
+		};
+
+		// Interned edge weights. Equal weights share one id, every edge holds a reference to its
+		// weight, and a weight is reclaimed once the last edge referring to it is erased.
+		// Deduplication is an O(1) hash lookup when std::hash<E> exists, and a binary search over
+		// the ids sorted by value otherwise.
+		template<typename E>
+		class weight_pool {
+		public:
+			using handle_type = std::uint32_t;
+
+			// Id of a weight equal to value, pooling it if needed. Takes one reference.
+			auto acquire(E const& value) -> handle_type {
+				if constexpr (hashed) {
+					auto id = find(value);
+					if (id == id_table::npos) {
+						index_.reserve(index_.size() + 1);
+						id = add(value);
+						index_.insert(id, std::hash<E>{}(value));
+					}
+					++refs_[id];
+					return id;
+				}
+				else {
+					auto const it = lower_bound(value);
+					if (it != index_.end() && values_[*it] == value) {
+						++refs_[*it];
+						return *it;
+					}
+					auto const id = add(value);
+					index_.insert(it, id);
+					++refs_[id];
+					return id;
+				}
+			}
+			// Ids for a sorted, duplicate-free run of values, pooling the missing ones in one pass.
+			// Takes no references: retain() each use, and reclaim() the ids if none end up used.
+			// Pools nothing if it throws.
+			auto intern(std::vector<E> const& values) -> std::vector<handle_type> {
+				auto ids = std::vector<handle_type>{};
+				ids.reserve(values.size());
+				if constexpr (hashed) {
+					index_.reserve(index_.size() + values.size());
+					try {
+						for (auto const& value : values) {
+							auto id = find(value);
+							if (id == id_table::npos) {
+								id = add(value);
+								index_.insert(id, std::hash<E>{}(value));
+							}
+							ids.push_back(id);
+						}
+					}
+					catch (...) {
+						reclaim(ids);
+						throw;
+					}
+				}
+				else {
+					auto added = std::vector<handle_type>{};
+					added.reserve(values.size());
+					auto merged = std::vector<handle_type>{};
+					merged.reserve(index_.size() + values.size());
+					try {
+						for (auto const& value : values) {
+							auto const it = lower_bound(value);
+							if (it != index_.end() && values_[*it] == value) {
+								ids.push_back(*it);
+							}
+							else {
+								ids.push_back(add(value));
+								added.push_back(ids.back());
+							}
+						}
+					}
+					catch (...) {
+						// Not indexed yet
+						for (auto const id : added) {
+							values_.erase(id);
+						}
+						throw;
+					}
+					std::merge(index_.begin(),
+					           index_.end(),
+					           added.begin(),
+					           added.end(),
+					           std::back_inserter(merged),
+					           [this](handle_type const a, handle_type const b) {
+						           return values_[a] < values_[b];
+					           });
+					index_ = std::move(merged);
+				}
+				return ids;
+			}
+			auto retain(handle_type const id) -> void {
+				++refs_[id];
+			}
+			// Drops one reference, reclaiming the weight when it was the last
+			auto release(handle_type const id) -> void {
+				if (--refs_[id] == 0) {
+					drop(id);
+				}
+			}
+			// Reclaims those of the interned ids that were never retained
+			auto reclaim(std::vector<handle_type> const& ids) -> void {
+				for (auto const id : ids) {
+					if (refs_[id] == 0) {
+						drop(id);
+					}
+				}
+			}
+			auto operator[](handle_type const id) const -> E const& {
+				return values_[id];
+			}
+			// Number of distinct weights in use
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return index_.size();
+			}
+			auto clear() noexcept -> void {
+				values_.clear();
+				refs_.clear();
+				index_.clear();
+			}
+
+		private:
+			static constexpr bool hashed = hashable<E>;
+
+			arena<E> values_{};
+			std::vector<std::uint32_t> refs_{};
+			// Hash set of ids, or the ids sorted by value
+			std::conditional_t<hashed, id_table, std::vector<handle_type>> index_{};
+
+			auto drop(handle_type const id) -> void {
+				if constexpr (hashed) {
+					index_.erase(id, std::hash<E>{}(values_[id]));
+				}
+				else {
+					index_.erase(lower_bound(values_[id]));
+				}
+				values_.erase(id);
+			}
+			auto add(E const& value) -> handle_type {
+				if (refs_.size() <= values_.id_limit()) {
+					refs_.resize(values_.id_limit() + 1);
+				}
+				auto const id = values_.insert(value);
+				refs_[id] = 0;
+				return id;
+			}
+			[[nodiscard]] auto find(E const& value) const -> handle_type {
+				return index_.find(std::hash<E>{}(value),
+				                   [&](handle_type const id) { return values_[id] == value; });
+			}
+			[[nodiscard]] auto lower_bound(E const& value) const ->
+			   typename std::vector<handle_type>::const_iterator {
+				return std::lower_bound(index_.begin(),
+				                        index_.end(),
+				                        value,
+				                        [this](handle_type const id, E const& v) {
+					                        return values_[id] < v;
+				                        });
+			}
+		};
+
+		// Weight storage with the weight_pool interface that keeps each edge's weight inline in the
+		// edge itself: the handle is the weight.
+		template<typename E>
+		class direct_weights {
+		public:
+			using handle_type = E;
+
+			auto acquire(E const& value) const -> handle_type {
+				return value;
+			}
+			auto intern(std::vector<E> const& values) const -> std::vector<handle_type> {
+				return values;
+			}
+			auto retain(handle_type const&) const noexcept -> void {}
+			auto release(handle_type const&) const noexcept -> void {}
+			auto reclaim(std::vector<handle_type> const&) const noexcept -> void {}
+			auto operator[](handle_type const& weight) const noexcept -> E const& {
+				return weight;
+			}
+			auto clear() noexcept -> void {}
+		};
+
+		// Grows v, geometrically, only if it is full, so that adding one element next cannot
+		// reallocate and, for nothrow-copyable T, cannot throw.
+		template<typename T>
+		auto make_room(std::vector<T>& v) -> void {
+			if (v.size() == v.capacity()) {
+				v.reserve(std::max(std::size_t{4}, 2 * v.size()));
+			}
+		}
+
+		// Makes p the only owner of its T, copying the T first if anything else still shares it.
+		template<typename T>
+		auto unshare(std::shared_ptr<T>& p) -> T& {
+			if (p.use_count() != 1) {
+				p = std::make_shared<T>(std::as_const(*p));
+			}
+			else {
+				// Pairs with the release in the last other owner's destructor, so that owner's
+				// reads of the T happen before this one starts writing to it.
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			return *p;
+		}
+
+		// A T that copies of its owner may share. Reads go through operator* and operator->; write()
+		// returns a T this object owns alone, copying it first if it is shared. With Shared false
+		// it is just a T and copies are deep.
+		template<typename T, bool Shared>
+		class cow {
+		public:
+			auto operator*() const noexcept -> T const& {
+				return value_;
+			}
+			auto operator->() const noexcept -> T const* {
+				return &value_;
+			}
+			auto write() noexcept -> T& {
+				return value_;
+			}
+			auto reset(T value) -> void {
+				value_ = std::move(value);
+			}
+
+		private:
+			[[no_unique_address]] T value_{};
+		};
+
+		template<typename T>
+		class cow<T, true> {
+		public:
+			auto operator*() const noexcept -> T const& {
+				return value_ ? *value_ : empty();
+			}
+			auto operator->() const noexcept -> T const* {
+				return &**this;
+			}
+			auto write() -> T& {
+				if (!value_) {
+					value_ = std::make_shared<T>();
+				}
+				return unshare(value_);
+			}
+			// Replaces the value without copying the old one
+			auto reset(T value) -> void {
+				value_ = std::make_shared<T>(std::move(value));
+			}
+
+		private:
+			// Null until first written, so default construction and moves never allocate
+			std::shared_ptr<T> value_{};
+
+			static auto empty() noexcept -> T const& {
+				static auto const value = T{};
+				return value;
+			}
+		};
+
+		// A vector of T whose copies may share storage in fixed-size chunks: write(i) copies only
+		// the chunk holding element i, and only if it is shared. With Shared false it is a plain
+		// std::vector<T>.
+		template<typename T, bool Shared>
+		class cow_array {
+		public:
+			auto operator[](std::size_t const i) const noexcept -> T const& {
+				return values_[i];
+			}
+			auto write(std::size_t const i) noexcept -> T& {
+				return values_[i];
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return values_.size();
+			}
+			// Grows to at least size elements
+			auto grow(std::size_t const size) -> void {
+				if (size > values_.size()) {
+					values_.resize(size);
+				}
+			}
+			auto clear() noexcept -> void {
+				values_.clear();
+			}
+
+		private:
+			std::vector<T> values_{};
+		};
+
+		template<typename T>
+		class cow_array<T, true> {
+		public:
+			auto operator[](std::size_t const i) const noexcept -> T const& {
+				return (*(*chunks_)[i / chunk_size])[i % chunk_size];
+			}
+			auto write(std::size_t const i) -> T& {
+				return unshare(chunks_.write()[i / chunk_size])[i % chunk_size];
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return size_;
+			}
+			auto grow(std::size_t const size) -> void {
+				if (size <= size_) {
+					return;
+				}
+				auto& chunks = chunks_.write();
+				while (chunks.size() * chunk_size < size) {
+					chunks.push_back(std::make_shared<chunk>());
+				}
+				size_ = size;
+			}
+			auto clear() noexcept -> void {
+				chunks_ = {};
+				size_ = 0;
+			}
+
+		private:
+			static constexpr std::size_t chunk_size = 64;
+			using chunk = std::array<T, chunk_size>;
+
+			cow<std::vector<std::shared_ptr<chunk>>, true> chunks_{};
+			std::size_t size_ = 0;
+		};
+
+		// Numbers std::to_chars formats as operator<< would. Character types print as characters.
+		template<typename T>
+		concept to_chars_formattable =
+		   std::floating_point<T>
+		   || (std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char>
+		       && !std::same_as<T, signed char> && !std::same_as<T, unsigned char>
+		       && !std::same_as<T, wchar_t> && !std::same_as<T, char8_t>
+		       && !std::same_as<T, char16_t> && !std::same_as<T, char32_t>);
+
+		// Writes to a stream through a block buffer, formatting numbers with std::to_chars. Output
+		// is what writing each piece with operator<< would give: when the stream's formatting is
+		// anything but the default, or for types other than numbers and strings, pieces go through
+		// operator<< after all. Call flush() when done.
+		class text_writer {
+		public:
+			explicit text_writer(std::ostream& os)
+			: os_{&os}
+			, plain_{os.flags() == (std::ios::skipws | std::ios::dec) && os.width() == 0
+			         && os.precision() >= 0 && os.getloc() == std::locale::classic()} {
+				if (plain_) {
+					buffer_.resize(block_size);
+				}
+			}
+
+			auto put(std::string_view const text) -> void {
+				if (!plain_) {
+					*os_ << text;
+					return;
+				}
+				if (text.size() > block_size - used_) {
+					flush();
+					if (text.size() > block_size) {
+						os_->write(text.data(), static_cast<std::streamsize>(text.size()));
+						return;
+					}
+				}
+				std::copy(text.begin(), text.end(), buffer_.data() + used_);
+				used_ += text.size();
+			}
+
+			template<typename T>
+			auto put(T const& value) -> void {
+				if constexpr (std::convertible_to<T const&, std::string_view>) {
+					put(std::string_view(value));
+				}
+				else if constexpr (to_chars_formattable<T>) {
+					if (!plain_) {
+						*os_ << value;
+						return;
+					}
+					if (block_size - used_ < max_number_size) {
+						flush();
+					}
+					auto* const first = buffer_.data() + used_;
+					auto* const last = buffer_.data() + block_size;
+					auto const result = [&] {
+						if constexpr (std::floating_point<T>) {
+							// The default float field is %g at the stream's precision.
+							return std::to_chars(first,
+							                     last,
+							                     value,
+							                     std::chars_format::general,
+							                     static_cast<int>(os_->precision()));
+						}
+						else {
+							return std::to_chars(first, last, value);
+						}
+					}();
+					if (result.ec != std::errc{}) {
+						flush();
+						*os_ << value;
+						return;
+					}
+					used_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+				}
+				else {
+					flush();
+					*os_ << value;
+				}
+			}
+
+			auto flush() -> void {
+				os_->write(buffer_.data(), static_cast<std::streamsize>(used_));
+				used_ = 0;
+			}
+
+		private:
+			static constexpr std::size_t block_size = std::size_t{1} << 16U;
+			// Room left for each number; longer ones (high precision floats) go through operator<<
+			static constexpr std::size_t max_number_size = 128;
+
+			std::ostream* os_;
+			bool plain_;
+			std::vector<char> buffer_{};
+			std::size_t used_ = 0;
+		};
+	} // namespace detail
+
+	// How graph<N, E> looks up a node by value.
+	//   hashed  - O(1) average lookup through a hash index kept alongside the node list. Requires
+	//             std::hash<N>.
+	//   ordered - O(log n) binary search over the (always sorted) node list. No extra memory.
+	enum class node_index { hashed, ordered };
+
+	// Lookup strategy used for a given node type. Specialise this to override the default, e.g.
+	//   template<>
+	//   inline constexpr auto gdwg::node_index_for<my_node> = gdwg::node_index::ordered;
+	template<typename N>
+	inline constexpr auto node_index_for =
+	   detail::hashable<N> ? node_index::hashed : node_index::ordered;
+
+	// How graph<N, E> stores edge weights.
+	//   interned - each distinct weight is stored once and edges refer to it by id. Deduplication is
+	//              a hash lookup if std::hash<E> exists, a binary search otherwise.
+	//   direct   - every edge holds its own copy of the weight. No lookup and no refcounting, which
+	//              is cheaper whenever E is no bigger than an id, as for scalars.
+	enum class weight_storage { interned, direct };
+
+	// Weight storage used for a given edge type. Specialise this to override the default, e.g.
+	//   template<>
+	//   inline constexpr auto gdwg::weight_storage_for<my_weight> = gdwg::weight_storage::direct;
+	template<typename E>
+	inline constexpr auto weight_storage_for =
+	   std::is_scalar_v<E> ? weight_storage::direct : weight_storage::interned;
+
+	// Which of a node's edges graph<N, E> can reach without looking at every node.
+	//   outgoing      - out-edges only. In-edge queries, erase_node, replace_node and
+	//                   merge_replace_node search every node's out-edges.
+	//   bidirectional - each node also lists the sources of its in-edges, so those operations take
+	//                   time proportional to the node's degree. Costs one id per connected
+	//                   (src, dst) pair.
+	enum class edge_index { outgoing, bidirectional };
+
+	// Edge index used for a given graph. Specialise this to override the default, e.g.
+	//   template<>
+	//   inline constexpr auto gdwg::edge_index_for<int, int> = gdwg::edge_index::outgoing;
+	template<typename N, typename E>
+	inline constexpr auto edge_index_for = edge_index::bidirectional;
+
+	// What copying a graph<N, E> does.
+	//   deep          - the copy gets its own storage, built in O(V + E).
+	//   copy_on_write - the copy shares the original's storage and is made in O(1). Whichever graph
+	//                   changes first copies just the storage it touches: the node table on a node
+	//                   change, the weight pool on a change to interned weights, and on an edge
+	//                   change the table of 64-node chunks (V / 64 pointers), the chunk and the
+	//                   bucket holding the edge. Reads pay an extra indirection or two. A copy may be
+	//                   read on one thread while the graph it was copied from is changed on another,
+	//                   as long as the copy is taken on the writer's thread.
+	enum class copy_mode { deep, copy_on_write };
+
+	// Copy mode used for a given graph. Specialise this to override the default, e.g.
+	//   template<>
+	//   inline constexpr auto gdwg::copy_mode_for<int, int> = gdwg::copy_mode::copy_on_write;
+	template<typename N, typename E>
+	inline constexpr auto copy_mode_for = copy_mode::deep;
+
+	template<typename N, typename E>
+	class frozen_graph;
+
+	namespace detail {
+		// Writes the binary graph format; see gdwg/mapped_graph.hpp.
+		template<typename N, typename E>
+		struct graph_file;
+		// Read access to a graph's storage by node id, for the algorithms in gdwg/algorithm.hpp.
+		template<typename N, typename E>
+		struct graph_view;
+	} // namespace detail
+
 	template<typename N, typename E>
 	class graph {
+		// Each node is stored once and referred to by a dense 32-bit id. Weights are either interned
+		// the same way or stored in the edge; see weight_storage.
+		using weight_store = std::conditional_t<weight_storage_for<E> == weight_storage::direct,
+		                                        detail::direct_weights<E>,
+		                                        detail::weight_pool<E>>;
+		using node_id = std::uint32_t;
+		using weight_id = typename weight_store::handle_type;
+		// An edge as stored in its source's bucket
+		struct out_edge {
+			node_id to;
+			weight_id weight;
+		};
+		using out_edge_list = std::vector<out_edge>;
+		using node_position = typename std::vector<node_id>::const_iterator;
+		using edge_position = typename out_edge_list::const_iterator;
+
 	public:
-		using adj_tuple = std::tuple<std::shared_ptr<N>, std::shared_ptr<N>, std::shared_ptr<E>>;
-		using adj_list_container = std::vector<adj_tuple>;
-		using node_list_container = std::vector<std::shared_ptr<N>>;
 		struct value_type {
 			value_type(N first, N second, E third)
 			: from{first}
@@ -29,21 +706,38 @@ namespace gdwg {
 			E weight;
 		};
 
+		// What an iterator dereferences to: the edge's endpoints and weight as references into the
+		// graph, so reading an edge copies nothing. Valid until the edge or either node is erased or
+		// replaced; convert to value_type to keep a copy.
+		struct edge_reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const {
+				return value_type{from, to, weight};
+			}
+		};
+
 		class iterator {
 		public:
 			using value_type = graph<N, E>::value_type;
-			using reference = value_type;
-			using adj_iterator = typename adj_list_container::const_iterator;
+			using reference = edge_reference;
 			using difference_type = std::ptrdiff_t;
 			using iterator_category = std::bidirectional_iterator_tag;
 
 			friend class graph;
 
 			auto operator*() const -> reference {
-				return reference{*std::get<0>(*it_), *std::get<1>(*it_), *std::get<2>(*it_)};
+				return reference{graph_->value_of(*node_),
+				                 graph_->value_of(edge_->to),
+				                 graph_->weight_of(edge_->weight)};
 			}
 			auto operator++() -> iterator& {
-				++it_;
+				++edge_;
+				if (edge_ == graph_->edges_of(*node_).end()) {
+					*this = graph_->first_edge_from(std::next(node_));
+				}
 				return *this;
 			}
 			auto operator++(int) -> iterator {
@@ -52,7 +746,13 @@ namespace gdwg {
 				return copy;
 			}
 			auto operator--() -> iterator& {
-				--it_;
+				if (node_ == graph_->nodes_->list.end() || edge_ == graph_->edges_of(*node_).begin()) {
+					do {
+						--node_;
+					} while (graph_->edges_of(*node_).empty());
+					edge_ = graph_->edges_of(*node_).end();
+				}
+				--edge_;
 				return *this;
 			}
 			auto operator--(int) -> iterator {
@@ -61,26 +761,155 @@ namespace gdwg {
 				return copy;
 			}
 
-			auto operator==(iterator const& other) const -> bool;
+			auto operator==(iterator const& other) const -> bool {
+				return graph_ == other.graph_ && node_ == other.node_ && edge_ == other.edge_;
+			}
 
 		private:
 			iterator() = default;
-			explicit iterator(const adj_list_container& adj, adj_iterator it)
-			: pointee_{&adj}
-			, it_{it} {};
-			adj_list_container const* pointee_ = nullptr;
-			adj_iterator it_{};
+			explicit iterator(graph const& g,
+			                  node_position node,
+			                  edge_position edge)
+			: graph_{&g}
+			, node_{node}
+			, edge_{edge} {};
+			graph const* graph_ = nullptr;
+			// Source of the current edge in nodes_->list, or nodes_->list.end() at the end
+			node_position node_{};
+			// Current edge in the source's bucket; value-initialised at the end
+			edge_position edge_{};
+		};
+
+		// Distinct destinations of a node's out-edges in ascending order, as references into the
+		// graph. Returned by connections_view; invalidated by any change to the graph.
+		class connection_view : public std::ranges::view_interface<connection_view> {
+		public:
+			class iterator {
+			public:
+				using value_type = N;
+				using reference = N const&;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				iterator() = default;
+
+				auto operator*() const -> reference {
+					return graph_->value_of(edge_->to);
+				}
+				auto operator++() -> iterator& {
+					auto const to = edge_->to;
+					do {
+						++edge_;
+					} while (edge_ != last_ && edge_->to == to);
+					return *this;
+				}
+				auto operator++(int) -> iterator {
+					auto copy = *this;
+					++*this;
+					return copy;
+				}
+
+				auto operator==(iterator const& other) const -> bool {
+					return edge_ == other.edge_;
+				}
+
+			private:
+				friend class connection_view;
+				iterator(graph const* g, out_edge const* edge, out_edge const* last)
+				: graph_{g}
+				, edge_{edge}
+				, last_{last} {}
+
+				graph const* graph_ = nullptr;
+				out_edge const* edge_ = nullptr;
+				out_edge const* last_ = nullptr;
+			};
+
+			connection_view() = default;
+
+			[[nodiscard]] auto begin() const -> iterator {
+				return iterator{graph_, first_, last_};
+			}
+			[[nodiscard]] auto end() const -> iterator {
+				return iterator{graph_, last_, last_};
+			}
+
+		private:
+			friend class graph;
+			connection_view(graph const& g, out_edge_list const& edges)
+			: graph_{&g}
+			, first_{edges.data()}
+			, last_{edges.data() + edges.size()} {}
+
+			graph const* graph_ = nullptr;
+			out_edge const* first_ = nullptr;
+			out_edge const* last_ = nullptr;
+		};
+
+		// Edge insertions and erasures recorded against a graph and applied together by commit(), as
+		// if by insert_edge and erase_edge in the order recorded, but with one sort-merge pass over
+		// each bucket they touch: O(B log B) for B changes plus the size of those buckets, rather
+		// than a search and a shift per change. Returned by graph::batch(); changes not committed are
+		// dropped with the batch.
+		class edge_batch {
+		public:
+			auto insert_edge(N const& src, N const& dst, E const& weight) -> edge_batch& {
+				changes_.push_back(change{src, dst, weight, true});
+				return *this;
+			}
+			auto erase_edge(N const& src, N const& dst, E const& weight) -> edge_batch& {
+				changes_.push_back(change{src, dst, weight, false});
+				return *this;
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return changes_.size();
+			}
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return changes_.empty();
+			}
+			// Applies every change and empties the batch. If an endpoint of any change is not a node
+			// by then, throws what insert_edge or erase_edge would for the first such change, and
+			// leaves both the graph and the batch unchanged.
+			auto commit() -> void {
+				graph_->apply(changes_);
+				changes_.clear();
+			}
+
+		private:
+			friend class graph;
+			struct change {
+				N from;
+				N to;
+				E weight;
+				bool insert;
+			};
+
+			explicit edge_batch(graph& g)
+			: graph_{&g} {}
+
+			graph* graph_;
+			std::vector<change> changes_{};
 		};
 
 		// Constructors
 		graph() = default;
 		graph(std::initializer_list<N> il);
 		template<typename InputIt>
+		requires(!std::same_as<std::iter_value_t<InputIt>, value_type>)
+		graph(InputIt first, InputIt last);
+		// Builds a graph from a range of edges; every endpoint becomes a node.
+		template<typename InputIt>
+		requires std::same_as<std::iter_value_t<InputIt>, value_type>
 		graph(InputIt first, InputIt last);
 		graph(graph&& other) noexcept
-		: node_list_{std::exchange(other.node_list_, node_list_container{})}
-		, adj_list_{std::exchange(other.adj_list_, adj_list_container{})} {}
-		graph(graph const& other);
+		: nodes_{std::exchange(other.nodes_, shareable<node_table>{})}
+		, weights_{std::exchange(other.weights_, shareable<weight_store>{})}
+		, out_edges_{std::exchange(other.out_edges_, shareable_array<out_edge_list>{})}
+		, in_sources_{std::exchange(other.in_sources_, in_index_container{})} {}
+		// Clones other's storage as is, in O(V + E): node ids, orderings and shared weights carry
+		// over unchanged, so no lookups or sorting are needed. O(1) with copy_on_write; see
+		// copy_mode.
+		graph(graph const& other) = default;
 		~graph() = default;
 
 		// Operators
@@ -88,21 +917,20 @@ namespace gdwg {
 		auto operator=(graph const& other) -> graph&;
 		[[nodiscard]] auto operator==(graph const& other) const -> bool;
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
-			if (g.node_list_.empty()) {
-				return os;
-			}
-
-			auto current_node = g.node_list_.begin();
-			auto current_edge = g.begin();
-			while (current_node != g.node_list_.end()) {
-				os << **current_node << " (\n";
-				while (current_edge != g.end() && (*current_edge).from == **current_node) {
-					os << "  " << (*current_edge).to << " | " << (*current_edge).weight << "\n";
-					current_edge++;
+			auto out = detail::text_writer(os);
+			for (auto const id : g.nodes_->list) {
+				out.put(g.value_of(id));
+				out.put(" (\n");
+				for (auto const& e : g.edges_of(id)) {
+					out.put("  ");
+					out.put(g.value_of(e.to));
+					out.put(" | ");
+					out.put(g.weight_of(e.weight));
+					out.put("\n");
 				}
-				os << ")\n";
-				current_node++;
+				out.put(")\n");
 			}
+			out.flush();
 			return os;
 		}
 
@@ -112,422 +940,1649 @@ namespace gdwg {
 		auto insert_edge(value_type tup) -> bool {
 			return insert_edge(tup.from, tup.to, tup.weight);
 		}
+		// Bulk inserts. Equivalent to calling insert_node/insert_edge on each element in turn, but
+		// the range is sorted and deduplicated once and merged into the graph in a single pass.
+		// insert_edges throws (without modifying the graph) if any endpoint is not a node; if
+		// copying a weight or allocating throws part way, the sources merged so far keep their new
+		// edges. Both return the number of nodes or edges actually added.
+		template<typename InputIt>
+		auto insert_nodes(InputIt first, InputIt last) -> std::size_t;
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t;
 		auto replace_node(N const& old_data, N const& new_data) -> bool;
+		// Moves every edge of old_data onto new_data, dropping duplicates, and erases old_data.
+		// Merging a node into itself changes nothing.
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void;
 		auto erase_node(N const& value) -> bool;
 		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool;
 		auto erase_edge(iterator i) -> iterator {
-			return iterator{adj_list_, adj_list_.erase(i.it_)};
+			auto const next = erase_out_edges(*i.node_, i.edge_, std::next(i.edge_));
+			return next == edges_of(*i.node_).end() ? first_edge_from(std::next(i.node_))
+			                                          : iterator{*this, i.node_, next};
+		}
+		auto erase_edge(iterator i, iterator s) -> iterator;
+		// Bulk erases, each one pass over the buckets it touches that keeps the remaining edges in
+		// order. erase_nodes erases the nodes in [first, last) with their edges, skipping values
+		// that are not nodes. erase_edges erases every out-edge of src. erase_edges_if erases the
+		// edges e for which pred(e) is true, e being an edge_reference; pred is called once per
+		// edge, in iteration order, and must not change the graph. Each returns the number of nodes
+		// or edges erased.
+		template<typename InputIt>
+		auto erase_nodes(InputIt first, InputIt last) -> std::size_t;
+		auto erase_edges(N const& src) -> std::size_t;
+		template<typename Pred>
+		auto erase_edges_if(Pred pred) -> std::size_t;
+		// An empty batch of edge changes for this graph; see edge_batch.
+		[[nodiscard]] auto batch() -> edge_batch {
+			return edge_batch(*this);
 		}
-		auto erase_edge(iterator i, iterator s) -> iterator {
-			return iterator{adj_list_, adj_list_.erase(i.it_, s.it_)};
-		};
 		auto clear() noexcept -> void {
-			adj_list_.clear();
-			node_list_.clear();
+			out_edges_.clear();
+			if constexpr (in_index) {
+				in_sources_.clear();
+			}
+			weights_ = {};
+			nodes_ = {};
 		}
 
 		// Accessors
 		[[nodiscard]] auto is_node(N const& value) const -> bool;
 		[[nodiscard]] auto empty() const -> bool {
-			return node_list_.empty();
+			return nodes_->list.empty();
 		}
 		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool;
 		[[nodiscard]] auto nodes() const -> std::vector<N>;
 		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E>;
 		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator;
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N>;
+		// Same nodes as connections(src), without copying them or allocating.
+		[[nodiscard]] auto connections_view(N const& src) const -> connection_view;
+		// Nodes with an edge to dst, in ascending order.
+		[[nodiscard]] auto in_connections(N const& dst) const -> std::vector<N>;
+		// Edges into dst in (from, weight) order, as references into the graph.
+		[[nodiscard]] auto in_edges(N const& dst) const -> std::vector<edge_reference>;
 
 		// Iterator access
 		[[nodiscard]] auto begin() const -> iterator {
-			return iterator{adj_list_, adj_list_.begin()};
+			return first_edge_from(nodes_->list.begin());
 		}
 		[[nodiscard]] auto end() const -> iterator {
-			return iterator{adj_list_, adj_list_.end()};
+			return iterator{*this, nodes_->list.end(), {}};
 		}
 
-		// OTHER
-		auto static tuple_sort(adj_tuple a, adj_tuple b) -> bool;
+		// Immutable compressed sparse row snapshot of this graph; see frozen_graph.
+		[[nodiscard]] auto freeze() const -> frozen_graph<N, E>;
 
 	private:
-		node_list_container node_list_{};
-		adj_list_container adj_list_{};
-		// Finds pointer to node heap resource and returns it
-		auto get_node(N const& value) const -> std::shared_ptr<N>;
-		// Finds pointer to an edge weight resource and returns it (Used to prevent making duplicate
-		// edges)
-		auto get_edge(E const& value) const -> std::shared_ptr<E>;
-		// Determines if edge weight already exists as heap resource
-		[[nodiscard]] auto is_edge(E const& value) const -> bool;
+		friend class frozen_graph<N, E>;
+		friend struct detail::graph_file<N, E>;
+		friend struct detail::graph_view<N, E>;
+
+		static constexpr bool hashed_index = node_index_for<N> == node_index::hashed;
+		static constexpr node_id no_node = std::numeric_limits<node_id>::max();
+
+		struct no_node_index {};
+		using node_index_container =
+		   std::conditional_t<hashed_index, detail::id_table, no_node_index>;
+
+		static constexpr bool in_index = edge_index_for<N, E> == edge_index::bidirectional;
+		struct no_in_index {};
+		// With copy_on_write each piece of storage sits behind a shared pointer; see copy_mode.
+		static constexpr bool shared_storage = copy_mode_for<N, E> == copy_mode::copy_on_write;
+		template<typename T>
+		using shareable = detail::cow<T, shared_storage && !std::is_empty_v<T>>;
+		template<typename T>
+		using shareable_array = detail::cow_array<shareable<T>, shared_storage>;
+
+		using in_index_container =
+		   std::conditional_t<in_index, shareable_array<std::vector<node_id>>, no_in_index>;
+
+		struct node_table {
+			detail::arena<N> values{};
+			// Every node id, sorted by value
+			std::vector<node_id> list{};
+			// Hashes values by id; empty when N uses the ordered index
+			[[no_unique_address]] node_index_container index{};
+		};
+
+		shareable<node_table> nodes_{};
+		[[no_unique_address]] shareable<weight_store> weights_{};
+		// Out-edges of each node, indexed by node id and sorted by (to, weight) value. Iterating
+		// nodes_->list and each node's bucket in turn visits every edge in (from, to, weight) order.
+		shareable_array<out_edge_list> out_edges_{};
+		// Nodes with at least one edge into each node, indexed by node id, once each and in no
+		// particular order; empty when edge_index_for<N, E> is outgoing
+		[[no_unique_address]] in_index_container in_sources_{};
+
+		auto value_of(node_id const id) const -> N const& {
+			return nodes_->values[id];
+		}
+		auto weight_of(weight_id const& weight) const -> E const& {
+			return (*weights_)[weight];
+		}
+		auto edges_of(node_id const id) const -> out_edge_list const& {
+			return *out_edges_[id];
+		}
+		// The bucket of id, copied first if another graph shares it. Positions into edges_of(id)
+		// taken before the call may refer to the shared copy.
+		auto writable_edges(node_id const id) -> out_edge_list& {
+			return out_edges_.write(id).write();
+		}
+
+		// An out-edge's sort key: a destination id and a weight value, which need not be pooled yet
+		struct edge_key {
+			node_id to;
+			E const& weight;
+		};
+		// Orders out-edges by (to, weight) value. Nodes are unique, so equal ids mean equal values
+		// and only differing ids need their values compared.
+		auto edge_before(out_edge const& e, edge_key const& key) const -> bool {
+			if (e.to != key.to) {
+				return value_of(e.to) < value_of(key.to);
+			}
+			return weight_of(e.weight) < key.weight;
+		}
+		auto key_before(edge_key const& key, out_edge const& e) const -> bool {
+			if (key.to != e.to) {
+				return value_of(key.to) < value_of(e.to);
+			}
+			return key.weight < weight_of(e.weight);
+		}
+		auto edge_less(out_edge const& a, out_edge const& b) const -> bool {
+			return edge_before(a, edge_key{b.to, weight_of(b.weight)});
+		}
+		auto node_less(node_id const a, node_id const b) const -> bool {
+			return a != b && value_of(a) < value_of(b);
+		}
+		// Position of the first out-edge of from that is not before key
+		auto edge_bound(node_id const from, edge_key const& key) const -> edge_position {
+			auto const& bucket = edges_of(from);
+			return std::lower_bound(bucket.begin(),
+			                        bucket.end(),
+			                        key,
+			                        [this](out_edge const& e, edge_key const& k) {
+				                        return edge_before(e, k);
+			                        });
+		}
+		// The out-edges of from that go to to
+		auto edge_range(node_id from, node_id to) const -> std::pair<edge_position, edge_position>;
+		// First edge whose source is at or after pos in nodes_->list, or end()
+		auto first_edge_from(node_position pos) const -> iterator;
+		// Sizes the per-node buckets for every id below limit
+		auto grow_buckets(std::size_t const limit) -> void {
+			out_edges_.grow(limit);
+			if constexpr (in_index) {
+				in_sources_.grow(out_edges_.size());
+			}
+		}
+
+		// The reverse index records each (from, to) pair with at least one edge. Edges to the same
+		// destination are adjacent in a bucket, so whether a pair still has edges after inserting
+		// or erasing at pos only depends on pos's neighbours.
+		static auto leads_to(out_edge_list const& bucket, edge_position pos, node_id const to)
+		   -> bool {
+			return (pos != bucket.end() && pos->to == to)
+			       || (pos != bucket.begin() && std::prev(pos)->to == to);
+		}
+		auto link(node_id const from, node_id const to) -> void {
+			if constexpr (in_index) {
+				in_sources_.write(to).write().push_back(from);
+			}
+		}
+		// Make the reverse index entry of to writable, with room for one more source for a link, so
+		// that a link or unlink called next cannot throw. Done before an edge change is made, so
+		// the bucket and the reverse index change together or not at all.
+		auto prepare_link(node_id const to) -> void {
+			if constexpr (in_index) {
+				detail::make_room(in_sources_.write(to).write());
+			}
+		}
+		auto prepare_unlink(node_id const to) -> void {
+			if constexpr (in_index) {
+				in_sources_.write(to).write();
+			}
+		}
+		auto unlink(node_id const from, node_id const to) -> void {
+			if constexpr (in_index) {
+				auto& sources = in_sources_.write(to).write();
+				*std::find(sources.begin(), sources.end(), from) = sources.back();
+				sources.pop_back();
+			}
+		}
+		// Unlinks each (from, to) pair. A destination losing several sources has its list compacted
+		// once instead of searched for each.
+		auto unlink_all(std::vector<std::pair<node_id, node_id>> const& pairs) -> void;
+		// Calls f once with each node that has an edge to to. f may change out_edges_ but not
+		// in_sources_[to].
+		template<typename F>
+		auto for_each_source(node_id to, F f) const -> void;
+		// Nodes with an edge to to, sorted by value
+		auto sorted_sources(node_id to) const -> std::vector<node_id>;
+		// Erases [first, last), positions into edges_of(from), from the bucket of from and returns
+		// the position after them. Weights and the reverse index are left alone.
+		auto cut_edges(node_id from, edge_position first, edge_position last) -> edge_position {
+			auto const offset = first - edges_of(from).begin();
+			auto const count = last - first;
+			auto& bucket = writable_edges(from);
+			return bucket.erase(bucket.begin() + offset, bucket.begin() + offset + count);
+		}
+		// Points the out-edges of from that go to old_id at new_id instead, merging them by weight
+		// into any edges already going there and releasing duplicates. The reverse index is left
+		// alone.
+		auto redirect_edges(node_id from, node_id old_id, node_id new_id) -> void;
+		// Erases [first, last) from the bucket of from, releasing the weights and unlinking pairs
+		// left without edges. Returns the position after the erased edges.
+		auto erase_out_edges(node_id from, edge_position first, edge_position last) -> edge_position;
+		// Commits an edge_batch's changes
+		auto apply(std::vector<typename edge_batch::change> const& changes) -> void;
+
+		static auto hash_of(N const& value) -> std::size_t {
+			return std::hash<N>{}(value);
+		}
+		// Id of the node equal to value, or no_node
+		auto locate_node(N const& value) const -> node_id;
+		// Position of the first node in nodes_->list that is not less than value
+		auto node_bound(N const& value) const -> typename std::vector<node_id>::const_iterator;
 	};
 
 	template<typename N, typename E>
 	template<typename InputIt>
+	requires(!std::same_as<std::iter_value_t<InputIt>, typename graph<N, E>::value_type>)
 	graph<N, E>::graph(InputIt first, InputIt last) {
-		while (first != last) {
-			insert_node(*first);
-			first++;
+		insert_nodes(first, last);
+	}
+
+	template<typename N, typename E>
+	template<typename InputIt>
+	requires std::same_as<std::iter_value_t<InputIt>, typename graph<N, E>::value_type>
+	graph<N, E>::graph(InputIt first, InputIt last) {
+		auto const edges = std::vector<value_type>(first, last);
+		auto endpoints = std::vector<N>{};
+		endpoints.reserve(2 * edges.size());
+		for (auto const& e : edges) {
+			endpoints.push_back(e.from);
+			endpoints.push_back(e.to);
 		}
+		insert_nodes(endpoints.begin(), endpoints.end());
+		insert_edges(edges.begin(), edges.end());
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::iterator::operator==(iterator const& other) const -> bool {
-		if (pointee_ != other.pointee_) {
+	graph<N, E>::graph(std::initializer_list<N> il) {
+		insert_nodes(il.begin(), il.end());
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::operator=(graph&& other) noexcept -> graph& {
+		std::swap(nodes_, other.nodes_);
+		std::swap(weights_, other.weights_);
+		std::swap(out_edges_, other.out_edges_);
+		std::swap(in_sources_, other.in_sources_);
+		other.clear();
+		return *this;
+	}
+
+	template<typename N, typename E>
+	// NOLINTNEXTLINE
+	auto graph<N, E>::operator=(graph const& other) -> graph& {
+		// Copy then swap in, so *this is untouched if copying throws.
+		if (this != &other) {
+			auto copy = other;
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::insert_node(N const& value) -> bool {
+		// nodes_->list is kept sorted, so the new node goes straight to its ordered position rather
+		// than being appended and re-sorted.
+		auto const pos = node_bound(value);
+		if (pos != nodes_->list.end() && value_of(*pos) == value) {
 			return false;
 		}
-		if (pointee_ == nullptr && other.pointee_ == nullptr) {
-			return true;
+		auto const offset = pos - nodes_->list.begin();
+		auto& nodes = nodes_.write();
+		// Allocate first, so a throw leaves no node slot behind. The new id is at most id_limit().
+		grow_buckets(nodes.values.id_limit() + 1);
+		detail::make_room(nodes.list);
+		if constexpr (hashed_index) {
+			nodes.index.reserve(nodes.list.size() + 1);
+		}
+		auto const id = nodes.values.insert(value);
+		nodes.list.insert(nodes.list.begin() + offset, id);
+		if constexpr (hashed_index) {
+			nodes.index.insert(id, hash_of(value));
+		}
+		return true;
+	}
+
+	template<typename N, typename E>
+	template<typename InputIt>
+	auto graph<N, E>::insert_nodes(InputIt first, InputIt last) -> std::size_t {
+		auto values = std::vector<N>(first, last);
+		std::sort(values.begin(), values.end());
+		values.erase(std::unique(values.begin(), values.end()), values.end());
+
+		// Both sides are sorted, so existing nodes are skipped with a forward-only search.
+		auto kept = std::size_t{0};
+		auto existing = nodes_->list.cbegin();
+		for (auto& value : values) {
+			existing = std::lower_bound(existing,
+			                            nodes_->list.cend(),
+			                            value,
+			                            [this](node_id const id, N const& v) {
+				                            return value_of(id) < v;
+			                            });
+			if (existing == nodes_->list.end() || !(value_of(*existing) == value)) {
+				if (&values[kept] != &value) {
+					values[kept] = std::move(value);
+				}
+				++kept;
+			}
+		}
+		if (kept == 0) {
+			return 0;
+		}
+		values.erase(values.begin() + static_cast<std::ptrdiff_t>(kept), values.end());
+
+		// Only now that something changes is the node table written, and so copied if shared.
+		// Everything else that allocates comes before the values take their slots, and the slots
+		// are given back if storing a value throws.
+		auto& nodes = nodes_.write();
+		auto added = std::vector<node_id>{};
+		added.reserve(values.size());
+		grow_buckets(nodes.values.id_limit() + values.size());
+		auto merged = std::vector<node_id>{};
+		merged.reserve(nodes.list.size() + values.size());
+		if constexpr (hashed_index) {
+			nodes.index.reserve(nodes.list.size() + values.size());
+		}
+		try {
+			for (auto& value : values) {
+				added.push_back(nodes.values.insert(std::move(value)));
+			}
+		}
+		catch (...) {
+			for (auto const id : added) {
+				nodes.values.erase(id);
+			}
+			throw;
+		}
+
+		if constexpr (hashed_index) {
+			for (auto const id : added) {
+				nodes.index.insert(id, hash_of(value_of(id)));
+			}
 		}
-		if (pointee_ == nullptr || other.pointee_ == nullptr) {
+		std::merge(nodes.list.begin(),
+		           nodes.list.end(),
+		           added.begin(),
+		           added.end(),
+		           std::back_inserter(merged),
+		           [this](node_id const a, node_id const b) { return node_less(a, b); });
+		nodes.list = std::move(merged);
+		return added.size();
+	}
+
+	template<typename N, typename E>
+	template<typename InputIt>
+	auto graph<N, E>::insert_edges(InputIt first, InputIt last) -> std::size_t {
+		struct staged_edge {
+			node_id from;
+			node_id to;
+			E weight;
+		};
+		auto const key_of = [](staged_edge const& e) { return edge_key{e.to, e.weight}; };
+		// Grouped by source; only the order within a source's bucket matters.
+		auto const staged_less = [this](staged_edge const& a, staged_edge const& b) {
+			if (a.from != b.from) {
+				return a.from < b.from;
+			}
+			if (a.to != b.to) {
+				return node_less(a.to, b.to);
+			}
+			return a.weight < b.weight;
+		};
+
+		// Resolve every endpoint up front so a missing node throws before anything changes.
+		auto staged = std::vector<staged_edge>{};
+		for (; first != last; ++first) {
+			auto const& e = *first;
+			auto const from = locate_node(e.from);
+			auto const to = locate_node(e.to);
+			if (from == no_node || to == no_node) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
+				                         "don't exist in the graph");
+			}
+			staged.push_back(staged_edge{from, to, e.weight});
+		}
+		std::sort(staged.begin(), staged.end(), staged_less);
+		staged.erase(std::unique(staged.begin(),
+		                         staged.end(),
+		                         [](staged_edge const& a, staged_edge const& b) {
+			                         return a.from == b.from && a.to == b.to && a.weight == b.weight;
+		                         }),
+		             staged.end());
+
+		// Drop edges that are already present. Each source's batch and bucket are both sorted, so
+		// one forward walk per bucket finds them.
+		auto kept = std::size_t{0};
+		auto source = no_node;
+		auto existing = edge_position{};
+		for (auto i = std::size_t{0}; i < staged.size(); ++i) {
+			auto const& bucket = edges_of(staged[i].from);
+			if (staged[i].from != source) {
+				source = staged[i].from;
+				existing = bucket.cbegin();
+			}
+			auto const key = key_of(staged[i]);
+			while (existing != bucket.cend() && edge_before(*existing, key)) {
+				++existing;
+			}
+			if (existing != bucket.cend() && !key_before(key, *existing)) {
+				continue;
+			}
+			if (kept != i) {
+				staged[kept] = std::move(staged[i]);
+			}
+			++kept;
+		}
+		staged.erase(staged.begin() + static_cast<std::ptrdiff_t>(kept), staged.end());
+		if (staged.empty()) {
+			return 0;
+		}
+
+		// Intern weights once: each distinct new weight shares an equal weight already in the
+		// graph if there is one, exactly as insert_edge would.
+		auto distinct = std::vector<E>{};
+		distinct.reserve(staged.size());
+		for (auto const& e : staged) {
+			distinct.push_back(e.weight);
+		}
+		std::sort(distinct.begin(), distinct.end());
+		distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+		auto const interned = weights_.write().intern(distinct);
+
+		// Merge each source's batch into its bucket. The new edges' weights are retained and their
+		// pairs linked only once the bucket is in place, so a throw while building it leaves that
+		// source untouched. Sources merged before the throw keep their edges; the weights interned
+		// above that none of them took are reclaimed.
+		auto retained = std::vector<weight_id>{};
+		auto linked = std::vector<node_id>{};
+		auto batch = staged.cbegin();
+		try {
+			while (batch != staged.cend()) {
+				auto const from = batch->from;
+				auto const batch_end = std::find_if(batch, staged.cend(), [from](staged_edge const& e) {
+					return e.from != from;
+				});
+				auto const& bucket = edges_of(from);
+				auto merged = out_edge_list{};
+				merged.reserve(bucket.size() + static_cast<std::size_t>(batch_end - batch));
+				existing = bucket.cbegin();
+				retained.clear();
+				retained.reserve(static_cast<std::size_t>(batch_end - batch));
+				linked.clear();
+				linked.reserve(static_cast<std::size_t>(batch_end - batch));
+				for (; batch != batch_end; ++batch) {
+					auto const key = key_of(*batch);
+					while (existing != bucket.cend() && edge_before(*existing, key)) {
+						merged.push_back(*existing++);
+					}
+					auto const w = interned[static_cast<std::size_t>(
+					   std::lower_bound(distinct.begin(), distinct.end(), batch->weight)
+					   - distinct.begin())];
+					retained.push_back(w);
+					if (!(!merged.empty() && merged.back().to == batch->to)
+					    && !(existing != bucket.cend() && existing->to == batch->to))
+					{
+						linked.push_back(batch->to);
+					}
+					merged.push_back(out_edge{batch->to, w});
+				}
+				merged.insert(merged.end(), existing, bucket.cend());
+				for (auto const to : linked) {
+					prepare_link(to);
+				}
+				out_edges_.write(from).reset(std::move(merged));
+				for (auto const w : retained) {
+					weights_.write().retain(w);
+				}
+				for (auto const to : linked) {
+					link(from, to);
+				}
+			}
+		}
+		catch (...) {
+			weights_.write().reclaim(interned);
+			throw;
+		}
+		return staged.size();
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+		auto const from = locate_node(src);
+		auto const to = locate_node(dst);
+		if (from == no_node || to == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node don't "
+			                         "exist in the graph");
 			return false;
 		}
-		if (it_ == pointee_->end() && other.it_ == pointee_->end()) {
-			return true;
+
+		// Buckets are kept sorted, so the edge's ordered position doubles as the duplicate check
+		// and it can be inserted there directly instead of appending and re-sorting.
+		auto const key = edge_key{to, weight};
+		auto const pos = edge_bound(from, key);
+		if (pos != edges_of(from).end() && !key_before(key, *pos)) {
+			return false;
+		}
+
+		auto const linked = leads_to(edges_of(from), pos, to);
+		auto const offset = pos - edges_of(from).begin();
+		// The bucket and, for a new pair, the reverse index are made writable with room for the
+		// edge before the weight is pooled, so neither the insert nor the link can throw and leave
+		// the weight's reference, the bucket and the reverse index disagreeing.
+		auto& bucket = writable_edges(from);
+		detail::make_room(bucket);
+		if (!linked) {
+			prepare_link(to);
+		}
+		auto const w = weights_.write().acquire(weight);
+		bucket.insert(bucket.begin() + offset, out_edge{to, w});
+		if (!linked) {
+			link(from, to);
+		}
+		return true;
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::replace_node(N const& old_data, N const& new_data) -> bool {
+		auto const id = locate_node(old_data);
+		if (id == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
+			                         "doesn't exist");
 		}
-		if (it_ == pointee_->end() || other.it_ == pointee_->end()) {
+
+		if (is_node(new_data)) {
 			return false;
 		}
-		return !static_cast<bool>((**this).from != (*other).from || (**this).to != (*other).to
-		                          || (**this).weight != (*other).weight);
+
+		// Edges refer to the node by id, so the node is renamed in place and only the orderings
+		// that depend on its value need fixing: nodes_->list, and the buckets of its in-edge sources,
+		// which are sorted by destination. Edges into it are taken out under the old value and put
+		// back under the new one.
+		auto moved = std::vector<std::pair<node_id, out_edge_list>>{};
+		for_each_source(id, [&](node_id const from) {
+			auto const [first, last] = edge_range(from, id);
+			moved.emplace_back(from, out_edge_list(first, last));
+			cut_edges(from, first, last);
+		});
+		auto& nodes = nodes_.write();
+		nodes.list.erase(node_bound(old_data));
+		if constexpr (hashed_index) {
+			nodes.index.erase(id, hash_of(old_data));
+		}
+		nodes.values[id] = new_data;
+		nodes.list.insert(node_bound(new_data), id);
+		if constexpr (hashed_index) {
+			nodes.index.insert(id, hash_of(new_data));
+		}
+
+		for (auto const& [from, edges] : moved) {
+			auto& bucket = writable_edges(from);
+			auto const pos = std::lower_bound(bucket.begin(),
+			                                  bucket.end(),
+			                                  id,
+			                                  [this](out_edge const& e, node_id const to) {
+				                                  return node_less(e.to, to);
+			                                  });
+			bucket.insert(pos, edges.begin(), edges.end());
+		}
+		return true;
 	}
 
 	template<typename N, typename E>
-	graph<N, E>::graph(std::initializer_list<N> il) {
-		for (auto i = il.begin(); i != il.end(); i++) {
-			insert_node(*i);
+	auto graph<N, E>::merge_replace_node(N const& old_data, N const& new_data) -> void {
+		auto const old_id = locate_node(old_data);
+		auto const new_id = locate_node(new_data);
+		if (old_id == no_node || new_id == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or new "
+			                         "data if they don't exist in the graph");
+		}
+		if (old_id == new_id) {
+			return;
+		}
+
+		// Edges into the old node are redirected where they are, in each source's bucket. Its own
+		// bucket is redirected the same way and then merged into the new node's in one pass.
+		for_each_source(old_id, [&](node_id const from) {
+			if (from != old_id && from != new_id) {
+				redirect_edges(from, old_id, new_id);
+			}
+		});
+		redirect_edges(old_id, old_id, new_id);
+		redirect_edges(new_id, old_id, new_id);
+
+		auto const& old_edges = edges_of(old_id);
+		auto const& new_edges = edges_of(new_id);
+		auto merged = out_edge_list{};
+		merged.reserve(old_edges.size() + new_edges.size());
+		auto a = new_edges.begin();
+		for (auto b = old_edges.begin(); b != old_edges.end(); ++b) {
+			while (a != new_edges.end() && edge_less(*a, *b)) {
+				merged.push_back(*a++);
+			}
+			if constexpr (in_index) {
+				// Each of the old node's destinations lists the new node in its place, unless the
+				// new node already has an edge there, which would be next to a.
+				if (b->to != new_id && (b == old_edges.begin() || std::prev(b)->to != b->to)) {
+					auto& sources = in_sources_.write(b->to).write();
+					auto const old_source = std::find(sources.begin(), sources.end(), old_id);
+					if (leads_to(new_edges, a, b->to)) {
+						*old_source = sources.back();
+						sources.pop_back();
+					}
+					else {
+						*old_source = new_id;
+					}
+				}
+			}
+			if (a != new_edges.end() && !edge_less(*b, *a)) {
+				weights_.write().release(b->weight);
+			}
+			else {
+				merged.push_back(*b);
+			}
+		}
+		merged.insert(merged.end(), a, new_edges.end());
+		if (!old_edges.empty()) {
+			writable_edges(new_id) = std::move(merged);
+			out_edges_.write(old_id) = {};
+		}
+		if constexpr (in_index) {
+			auto sources = *in_sources_[new_id];
+			sources.insert(sources.end(), in_sources_[old_id]->begin(), in_sources_[old_id]->end());
+			std::replace(sources.begin(), sources.end(), old_id, new_id);
+			std::sort(sources.begin(), sources.end());
+			sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+			in_sources_.write(new_id).write() = std::move(sources);
+			in_sources_.write(old_id) = {};
 		}
+
+		auto& nodes = nodes_.write();
+		nodes.list.erase(node_bound(old_data));
+		if constexpr (hashed_index) {
+			nodes.index.erase(old_id, hash_of(old_data));
+		}
+		nodes.values.erase(old_id);
 	}
 
 	template<typename N, typename E>
-	graph<N, E>::graph(graph const& other) {
-		for (auto node : other.node_list_) {
-			auto const copy = *node;
-			insert_node(copy);
+	auto graph<N, E>::redirect_edges(node_id const from, node_id const old_id, node_id const new_id)
+	   -> void {
+		auto const& bucket = edges_of(from);
+		auto const [old_first, old_last] = edge_range(from, old_id);
+		if (old_first == old_last) {
+			return;
+		}
+		auto const [new_first, new_last] = edge_range(from, new_id);
+		auto const a = old_first - bucket.begin();
+		auto const b = old_last - bucket.begin();
+		auto const c = new_first - bucket.begin();
+		auto const d = new_last - bucket.begin();
+
+		// The redirected edges are rotated up against the edges to new_id, if any, then the two
+		// runs, each sorted by weight, are merged.
+		auto& edges = writable_edges(from);
+		for (auto it = edges.begin() + a; it != edges.begin() + b; ++it) {
+			it->to = new_id;
+		}
+		auto first = edges.begin();
+		auto middle = edges.begin();
+		auto last = edges.begin();
+		if (b <= c) {
+			std::rotate(edges.begin() + a, edges.begin() + b, edges.begin() + c);
+			first += a + c - b;
+			middle += c;
+			last += d;
+		}
+		else {
+			std::rotate(edges.begin() + d, edges.begin() + a, edges.begin() + b);
+			first += c;
+			middle += d;
+			last += d + b - a;
+		}
+		if (c == d) {
+			return;
 		}
-		for (auto tuple : other.adj_list_) {
-			auto const n1 = *std::get<0>(tuple);
-			auto const n2 = *std::get<1>(tuple);
-			auto const n3 = *std::get<2>(tuple);
-			insert_edge(*get_node(n1), *get_node(n2), n3);
+		auto const weight_less = [this](out_edge const& x, out_edge const& y) {
+			return weight_of(x.weight) < weight_of(y.weight);
+		};
+		std::inplace_merge(first, middle, last, weight_less);
+		auto kept = first;
+		for (auto it = first; it != last; ++it) {
+			if (it != first && !weight_less(*std::prev(kept), *it)) {
+				weights_.write().release(it->weight);
+			}
+			else {
+				*kept++ = *it;
+			}
 		}
+		edges.erase(kept, last);
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::operator=(graph&& other) noexcept -> graph& {
-		std::swap(node_list_, other.node_list_);
-		std::swap(adj_list_, other.adj_list_);
-		other.node_list_ = node_list_container{};
-		other.adj_list_ = adj_list_container{};
-		return *this;
+	auto graph<N, E>::erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+		if (is_node(src) == false || is_node(dst) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they "
+			                         "don't exist in the graph");
+		}
+		auto it = find(src, dst, weight);
+		if (it != end()) {
+			erase_edge(it);
+			return true;
+		}
+		return false;
 	}
 
 	template<typename N, typename E>
-	// NOLINTNEXTLINE
-	auto graph<N, E>::operator=(graph const& other) -> graph& {
-		if (*this == other) {
-			return *this;
+	auto graph<N, E>::erase_edge(iterator i, iterator s) -> iterator {
+		// Whole buckets are cut at a time, up to the bucket s is in.
+		while (i.node_ != s.node_) {
+			erase_out_edges(*i.node_, i.edge_, edges_of(*i.node_).cend());
+			i = first_edge_from(std::next(i.node_));
+		}
+		if (i.node_ == nodes_->list.end()) {
+			return i;
 		}
+		auto const next = erase_out_edges(*i.node_, i.edge_, s.edge_);
+		return next == edges_of(*i.node_).end() ? first_edge_from(std::next(i.node_))
+		                                          : iterator{*this, i.node_, next};
+	}
 
-		node_list_.clear();
-		adj_list_.clear();
+	template<typename N, typename E>
+	auto graph<N, E>::apply(std::vector<typename edge_batch::change> const& changes) -> void {
+		struct staged_change {
+			node_id from;
+			node_id to;
+			E const* weight;
+			std::size_t order;
+			bool insert;
+		};
 
-		for (auto node : other.node_list_) {
-			auto copy = *node;
-			insert_node(copy);
+		// Resolve every endpoint up front so a missing node throws before anything changes.
+		auto staged = std::vector<staged_change>{};
+		staged.reserve(changes.size());
+		for (auto i = std::size_t{0}; i < changes.size(); ++i) {
+			auto const& c = changes[i];
+			auto const from = locate_node(c.from);
+			auto const to = locate_node(c.to);
+			if (from == no_node || to == no_node) {
+				throw std::runtime_error(
+				   c.insert ? "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist "
+				              "in the graph"
+				            : "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't "
+				              "exist in the graph");
+			}
+			staged.push_back(staged_change{from, to, &c.weight, i, c.insert});
 		}
-		for (auto tuple : other.adj_list_) {
-			auto const n1 = *std::get<0>(tuple);
-			auto const n2 = *std::get<1>(tuple);
-			auto const n3 = *std::get<2>(tuple);
-			insert_edge(*get_node(n1), *get_node(n2), n3);
+		// Grouped by source and destination id first, which compares no values, then each source's
+		// few changes into bucket order, with each edge's changes in the order recorded. Whatever
+		// came before, the last change to an edge decides whether it stays.
+		std::sort(staged.begin(), staged.end(), [](staged_change const& a, staged_change const& b) {
+			if (a.from != b.from) {
+				return a.from < b.from;
+			}
+			return a.to != b.to ? a.to < b.to : a.order < b.order;
+		});
+		for (auto first = staged.begin(); first != staged.end();) {
+			auto const from = first->from;
+			auto const last = std::find_if(first, staged.end(), [from](staged_change const& c) {
+				return c.from != from;
+			});
+			std::sort(first, last, [this](staged_change const& a, staged_change const& b) {
+				if (a.to != b.to) {
+					return node_less(a.to, b.to);
+				}
+				if (*a.weight < *b.weight || *b.weight < *a.weight) {
+					return *a.weight < *b.weight;
+				}
+				return a.order < b.order;
+			});
+			first = last;
 		}
-		return *this;
-	}
+		auto const same_edge = [](staged_change const& a, staged_change const& b) {
+			return a.from == b.from && a.to == b.to && *a.weight == *b.weight;
+		};
+		auto last_changes = std::size_t{0};
+		for (auto i = std::size_t{0}; i < staged.size(); ++i) {
+			if (i + 1 == staged.size() || !same_edge(staged[i], staged[i + 1])) {
+				staged[last_changes++] = staged[i];
+			}
+		}
+		staged.erase(staged.begin() + static_cast<std::ptrdiff_t>(last_changes), staged.end());
 
-	template<typename N, typename E>
-	auto graph<N, E>::insert_node(N const& value) -> bool {
-		for (auto node : node_list_) {
-			if (*node == value) {
-				return false;
+		// Merge each source's changes into its bucket through one scratch list, skipping those that
+		// insert an edge already there or erase one that is not. Only buckets that change are
+		// written, and so copied if shared. As in insert_edge and erase_out_edges, whether a pair
+		// keeps any edges only depends on its neighbours in the merge.
+		//
+		// A source's weights are acquired as its merge goes, and given back if anything throws
+		// before its bucket is written. Erased edges' weights are only released, and the reverse
+		// index only changed, after that.
+		auto merged = out_edge_list{};
+		auto acquired = std::vector<weight_id>{};
+		auto released = std::vector<weight_id>{};
+		auto linked = std::vector<node_id>{};
+		auto unlinked = std::vector<node_id>{};
+		auto batch = staged.cbegin();
+		while (batch != staged.cend()) {
+			auto const from = batch->from;
+			auto const& bucket = edges_of(from);
+			auto existing = bucket.cbegin();
+			auto const leads_to = [&](node_id const to) {
+				return (!merged.empty() && merged.back().to == to)
+				       || (existing != bucket.cend() && existing->to == to);
+			};
+			auto const batch_end = std::find_if(batch, staged.cend(), [from](staged_change const& c) {
+				return c.from != from;
+			});
+			auto changed = false;
+			merged.clear();
+			acquired.clear();
+			released.clear();
+			linked.clear();
+			unlinked.clear();
+			acquired.reserve(static_cast<std::size_t>(batch_end - batch));
+			released.reserve(static_cast<std::size_t>(batch_end - batch));
+			linked.reserve(static_cast<std::size_t>(batch_end - batch));
+			unlinked.reserve(static_cast<std::size_t>(batch_end - batch));
+			try {
+				for (; batch != batch_end; ++batch) {
+					auto const key = edge_key{batch->to, *batch->weight};
+					while (existing != bucket.cend() && edge_before(*existing, key)) {
+						merged.push_back(*existing++);
+					}
+					auto const present = existing != bucket.cend() && !key_before(key, *existing);
+					if (batch->insert == present) {
+						continue;
+					}
+					changed = true;
+					if (batch->insert) {
+						auto const was_linked = leads_to(batch->to);
+						detail::make_room(merged);
+						acquired.push_back(weights_.write().acquire(key.weight));
+						merged.push_back(out_edge{batch->to, acquired.back()});
+						if (!was_linked) {
+							linked.push_back(batch->to);
+						}
+					}
+					else {
+						released.push_back(existing++->weight);
+						if (!leads_to(batch->to)) {
+							unlinked.push_back(batch->to);
+						}
+					}
+				}
+				if (changed) {
+					merged.insert(merged.end(), existing, bucket.cend());
+					for (auto const to : unlinked) {
+						prepare_unlink(to);
+					}
+					for (auto const to : linked) {
+						prepare_link(to);
+					}
+					writable_edges(from).assign(merged.begin(), merged.end());
+				}
+			}
+			catch (...) {
+				for (auto const w : acquired) {
+					weights_.write().release(w);
+				}
+				throw;
+			}
+			for (auto const w : released) {
+				weights_.write().release(w);
+			}
+			for (auto const to : unlinked) {
+				unlink(from, to);
+			}
+			for (auto const to : linked) {
+				link(from, to);
 			}
 		}
-		node_list_.push_back(std::make_shared<N>(value));
-		std::sort(node_list_.begin(),
-		          node_list_.end(),
-		          [](std::shared_ptr<N> a, std::shared_ptr<N> b) -> bool { return (*a < *b); });
-		return true;
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::tuple_sort(adj_tuple a, adj_tuple b) -> bool {
-		if (*std::get<0>(a) < *std::get<0>(b)) {
-			return true;
-		}
-		if (*std::get<0>(a) == *std::get<0>(b)) {
-			if (*std::get<1>(a) < *std::get<1>(b)) {
-				return true;
-			}
-			if (*std::get<1>(a) == *std::get<1>(b)) {
-				if (*std::get<2>(a) < *std::get<2>(b)) {
-					return true;
+	auto graph<N, E>::erase_out_edges(node_id const from,
+	                                  edge_position const first,
+	                                  edge_position const last) -> edge_position {
+		auto const& bucket = edges_of(from);
+		for (auto it = first; it != last; ++it) {
+			weights_.write().release(it->weight);
+			// Only the first and last destinations in the range can have edges outside it.
+			if (it == first || std::prev(it)->to != it->to) {
+				auto const kept_before =
+				   it == first && first != bucket.begin() && std::prev(first)->to == it->to;
+				auto const kept_after = last != bucket.end() && last->to == it->to;
+				if (!kept_before && !kept_after) {
+					unlink(from, it->to);
 				}
 			}
 		}
-		return false;
+		return cut_edges(from, first, last);
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-		if (!is_node(src) || !is_node(dst)) {
-			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node don't "
-			                         "exist in the graph");
+	auto graph<N, E>::erase_node(N const& value) -> bool {
+		auto const id = locate_node(value);
+		if (id == no_node) {
 			return false;
 		}
-
-		if (find(src, dst, weight) != end()) {
-			return false;
+		// Edges into the node are cut from their sources' buckets; its own bucket and reverse index
+		// entry go with it.
+		for_each_source(id, [&](node_id const from) {
+			if (from == id) {
+				return;
+			}
+			auto const [first, last] = edge_range(from, id);
+			for (auto it = first; it != last; ++it) {
+				weights_.write().release(it->weight);
+			}
+			cut_edges(from, first, last);
+		});
+		auto const& bucket = edges_of(id);
+		for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+			weights_.write().release(it->weight);
+			if (it->to != id && (it == bucket.begin() || std::prev(it)->to != it->to)) {
+				unlink(id, it->to);
+			}
 		}
-
-		std::shared_ptr<E> edge;
-		if (is_edge(weight)) {
-			edge = get_edge(weight);
+		out_edges_.write(id) = {};
+		if constexpr (in_index) {
+			in_sources_.write(id) = {};
 		}
-		else {
-			edge = std::make_shared<E>(weight);
+
+		auto& nodes = nodes_.write();
+		nodes.list.erase(node_bound(value));
+		if constexpr (hashed_index) {
+			nodes.index.erase(id, hash_of(value));
 		}
-		auto const tuple_edge = adj_tuple{get_node(src), get_node(dst), edge};
-		adj_list_.push_back(tuple_edge);
-		std::sort(adj_list_.begin(), adj_list_.end(), tuple_sort);
+		nodes.values.erase(id);
 		return true;
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::replace_node(N const& old_data, N const& new_data) -> bool {
-		if (is_node(old_data) == false) {
-			throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
-			                         "doesn't exist");
+	template<typename InputIt>
+	auto graph<N, E>::erase_nodes(InputIt first, InputIt last) -> std::size_t {
+		// A byte of flags per node id: whether the node is erased, and whether it is already listed
+		// as a source or destination of an edge touching an erased node.
+		constexpr auto erasing = std::uint8_t{1};
+		constexpr auto source = std::uint8_t{2};
+		constexpr auto target = std::uint8_t{4};
+		auto flags = std::vector<std::uint8_t>{};
+		auto erased = std::vector<node_id>{};
+		for (; first != last; ++first) {
+			auto const id = locate_node(*first);
+			if (id == no_node) {
+				continue;
+			}
+			if (flags.empty()) {
+				flags.resize(nodes_->values.id_limit());
+			}
+			if (flags[id] == 0) {
+				flags[id] = erasing;
+				erased.push_back(id);
+			}
 		}
+		if (erased.empty()) {
+			return 0;
+		}
+		auto const is_erased = [&](node_id const id) { return (flags[id] & erasing) != 0; };
 
-		if (is_node(new_data)) {
-			return false;
+		// Edges into erased nodes are compacted out of each other source's bucket in one pass.
+		// Buckets without such edges are left unwritten, and so not copied if shared.
+		auto const cut = [&](node_id const from) {
+			auto const& bucket = edges_of(from);
+			auto const hit = std::find_if(bucket.begin(), bucket.end(), [&](out_edge const& e) {
+				return is_erased(e.to);
+			});
+			if (hit == bucket.end()) {
+				return;
+			}
+			auto const offset = hit - bucket.begin();
+			auto& edges = writable_edges(from);
+			auto& weights = weights_.write();
+			auto kept = edges.begin() + offset;
+			for (auto it = kept; it != edges.end(); ++it) {
+				if (is_erased(it->to)) {
+					weights.release(it->weight);
+				}
+				else {
+					*kept++ = *it;
+				}
+			}
+			edges.erase(kept, edges.end());
+		};
+		if constexpr (in_index) {
+			auto sources = std::vector<node_id>{};
+			for (auto const to : erased) {
+				for (auto const from : *in_sources_[to]) {
+					if (flags[from] == 0) {
+						flags[from] = source;
+						sources.push_back(from);
+					}
+				}
+			}
+			for (auto const from : sources) {
+				cut(from);
+			}
+		}
+		else {
+			for (auto const from : nodes_->list) {
+				if (!is_erased(from)) {
+					cut(from);
+				}
+			}
 		}
 
-		insert_node(new_data);
-		auto const new_node = get_node(new_data);
-		for (auto& tuple : adj_list_) {
-			if (*std::get<0>(tuple) == old_data) {
-				std::get<0>(tuple) = new_node;
+		// The erased nodes' own buckets and reverse index entries go with them, and they are
+		// dropped from the reverse index of each remaining destination in one pass over it.
+		auto targets = std::vector<node_id>{};
+		for (auto const id : erased) {
+			for (auto const& e : edges_of(id)) {
+				weights_.write().release(e.weight);
+				if constexpr (in_index) {
+					if ((flags[e.to] & (erasing | target)) == 0) {
+						flags[e.to] |= target;
+						targets.push_back(e.to);
+					}
+				}
 			}
-			if (*std::get<1>(tuple) == old_data) {
-				std::get<1>(tuple) = new_node;
+			out_edges_.write(id) = {};
+			if constexpr (in_index) {
+				in_sources_.write(id) = {};
+			}
+		}
+		if constexpr (in_index) {
+			for (auto const to : targets) {
+				std::erase_if(in_sources_.write(to).write(), is_erased);
 			}
 		}
 
-		for (auto it = node_list_.begin(); it != node_list_.end(); ++it) {
-			if (**it == old_data) {
-				node_list_.erase(it);
-				break;
+		auto& nodes = nodes_.write();
+		std::erase_if(nodes.list, is_erased);
+		for (auto const id : erased) {
+			if constexpr (hashed_index) {
+				nodes.index.erase(id, hash_of(nodes.values[id]));
 			}
+			nodes.values.erase(id);
 		}
-		return true;
+		return erased.size();
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::merge_replace_node(N const& old_data, N const& new_data) -> void {
-		if (is_node(old_data) == false || is_node(new_data) == false) {
-			throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or new "
-			                         "data if they don't exist in the graph");
+	auto graph<N, E>::erase_edges(N const& src) -> std::size_t {
+		auto const from = locate_node(src);
+		if (from == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edges if src doesn't exist "
+			                         "in the graph");
+		}
+		auto const& bucket = edges_of(from);
+		auto const erased = bucket.size();
+		if (erased == 0) {
+			return 0;
+		}
+		for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+			weights_.write().release(it->weight);
+			if (it == bucket.begin() || std::prev(it)->to != it->to) {
+				unlink(from, it->to);
+			}
 		}
-		auto vec = std::vector<value_type>{};
-		for (auto tuple : adj_list_) {
-			if (*std::get<0>(tuple) == old_data && *std::get<1>(tuple) == old_data) {
-				vec.push_back(value_type{new_data, new_data, *std::get<2>(tuple)});
+		out_edges_.write(from) = {};
+		return erased;
+	}
+
+	template<typename N, typename E>
+	template<typename Pred>
+	auto graph<N, E>::erase_edges_if(Pred pred) -> std::size_t {
+		auto const matches = [&](node_id const from, out_edge const& e) -> bool {
+			return pred(edge_reference{value_of(from), value_of(e.to), weight_of(e.weight)});
+		};
+		auto erased = std::size_t{0};
+		auto unlinked = std::vector<std::pair<node_id, node_id>>{};
+		auto const unlink_later = [&](node_id const from, node_id const to) {
+			if constexpr (in_index) {
+				unlinked.emplace_back(from, to);
 			}
-			else if (*std::get<0>(tuple) == old_data) {
-				vec.push_back(value_type{new_data, *std::get<1>(tuple), *std::get<2>(tuple)});
+		};
+		for (auto const from : nodes_->list) {
+			// Buckets without a match are left unwritten, and so not copied if shared.
+			auto const& bucket = edges_of(from);
+			auto const hit = std::find_if(bucket.begin(), bucket.end(), [&](out_edge const& e) {
+				return matches(from, e);
+			});
+			if (hit == bucket.end()) {
+				continue;
+			}
+			auto const offset = hit - bucket.begin();
+			auto& edges = writable_edges(from);
+			auto& weights = weights_.write();
+			// Kept edges move down over erased ones. Edges to the same destination are adjacent, so
+			// a pair is unlinked when its run ends with nothing kept.
+			auto const first = edges.begin() + offset;
+			auto kept = first;
+			auto to = first->to;
+			auto linked = first != edges.begin() && std::prev(first)->to == to;
+			for (auto it = first; it != edges.end(); ++it) {
+				if (it->to != to) {
+					if (!linked) {
+						unlink_later(from, to);
+					}
+					to = it->to;
+					linked = false;
+				}
+				if (it != first && !matches(from, *it)) {
+					*kept++ = *it;
+					linked = true;
+				}
+				else {
+					weights.release(it->weight);
+					++erased;
+				}
 			}
-			else if (*std::get<1>(tuple) == old_data) {
-				vec.push_back(value_type{*std::get<0>(tuple), new_data, *std::get<2>(tuple)});
+			if (!linked) {
+				unlink_later(from, to);
 			}
+			edges.erase(kept, edges.end());
 		}
+		unlink_all(unlinked);
+		return erased;
+	}
 
-		for (auto i : vec) {
-			insert_edge(i);
+	template<typename N, typename E>
+	auto graph<N, E>::locate_node(N const& value) const -> node_id {
+		if constexpr (hashed_index) {
+			return nodes_->index.find(hash_of(value),
+			                        [&](node_id const id) { return value_of(id) == value; });
+		}
+		else {
+			auto const it = node_bound(value);
+			return it == nodes_->list.end() || !(value_of(*it) == value) ? no_node : *it;
 		}
+	}
 
-		erase_node(old_data);
+	template<typename N, typename E>
+	auto graph<N, E>::node_bound(N const& value) const ->
+	   typename std::vector<node_id>::const_iterator {
+		return std::lower_bound(nodes_->list.begin(),
+		                        nodes_->list.end(),
+		                        value,
+		                        [this](node_id const id, N const& v) { return value_of(id) < v; });
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-		if (is_node(src) == false || is_node(dst) == false) {
-			throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they "
-			                         "don't exist in the graph");
-		}
-		auto it = find(src, dst, weight);
-		if (it != end()) {
-			erase_edge(it);
-			return true;
-		}
-		return false;
+	auto graph<N, E>::edge_range(node_id const from, node_id const to) const
+	   -> std::pair<edge_position, edge_position> {
+		auto const& bucket = edges_of(from);
+		auto const first = std::lower_bound(bucket.begin(),
+		                                    bucket.end(),
+		                                    to,
+		                                    [this](out_edge const& e, node_id const id) {
+			                                    return node_less(e.to, id);
+		                                    });
+		auto const last = std::upper_bound(first,
+		                                   bucket.end(),
+		                                   to,
+		                                   [this](node_id const id, out_edge const& e) {
+			                                   return node_less(id, e.to);
+		                                   });
+		return {first, last};
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::erase_node(N const& value) -> bool {
-		if (!is_node(value)) {
-			return false;
-		}
-		auto it = adj_list_.begin();
-		while (it != adj_list_.end()) {
-			if (*std::get<0>(*it) == value || *std::get<1>(*it) == value) {
-				it = adj_list_.erase(it);
+	auto graph<N, E>::first_edge_from(node_position pos) const -> iterator {
+		pos = std::find_if(pos, nodes_->list.end(), [this](node_id const id) {
+			return !edges_of(id).empty();
+		});
+		return pos == nodes_->list.end() ? end() : iterator{*this, pos, edges_of(*pos).begin()};
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::unlink_all(std::vector<std::pair<node_id, node_id>> const& pairs) -> void {
+		if constexpr (in_index) {
+			if (pairs.empty()) {
+				return;
 			}
-			else {
-				++it;
+			// Sources grouped by destination with a counting sort
+			auto const size = in_sources_.size();
+			auto offsets = std::vector<std::size_t>(size + 1);
+			for (auto const& [from, to] : pairs) {
+				++offsets[to + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			auto sources = std::vector<node_id>(pairs.size());
+			auto next = offsets;
+			for (auto const& [from, to] : pairs) {
+				sources[next[to]++] = from;
 			}
-		}
 
-		for (auto it2 = node_list_.begin(); it2 != node_list_.end(); ++it2) {
-			if (**it2 == value) {
-				node_list_.erase(it2);
-				break;
+			auto removed = std::vector<bool>(size);
+			for (auto to = std::size_t{0}; to < size; ++to) {
+				auto const first = sources.begin() + static_cast<std::ptrdiff_t>(offsets[to]);
+				auto const last = sources.begin() + static_cast<std::ptrdiff_t>(offsets[to + 1]);
+				if (last - first == 1) {
+					unlink(*first, static_cast<node_id>(to));
+				}
+				else if (first != last) {
+					std::for_each(first, last, [&](node_id const from) { removed[from] = true; });
+					std::erase_if(in_sources_.write(to).write(),
+					              [&](node_id const from) { return removed[from]; });
+					std::for_each(first, last, [&](node_id const from) { removed[from] = false; });
+				}
 			}
 		}
-		return true;
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::get_node(N const& value) const -> std::shared_ptr<N> {
-		for (auto node : node_list_) {
-			if (*node == value) {
-				return node;
+	template<typename F>
+	auto graph<N, E>::for_each_source(node_id const to, F f) const -> void {
+		if constexpr (in_index) {
+			for (auto const from : *in_sources_[to]) {
+				f(from);
 			}
 		}
-		return nullptr;
-	}
-
-	template<typename N, typename E>
-	auto graph<N, E>::get_edge(E const& value) const -> std::shared_ptr<E> {
-		for (auto tuple : adj_list_) {
-			auto const edge = std::get<2>(tuple);
-			if (*edge == value) {
-				return edge;
+		else {
+			for (auto const from : nodes_->list) {
+				auto const [first, last] = edge_range(from, to);
+				if (first != last) {
+					f(from);
+				}
 			}
 		}
-		return nullptr;
 	}
 
 	template<typename N, typename E>
-	auto graph<N, E>::is_edge(E const& value) const -> bool {
-		for (auto tuple : adj_list_) {
-			auto const edge = std::get<2>(tuple);
-			if (*edge == value) {
-				return true;
-			}
-		}
-		return false;
+	auto graph<N, E>::sorted_sources(node_id const to) const -> std::vector<node_id> {
+		auto sources = std::vector<node_id>{};
+		for_each_source(to, [&](node_id const from) { sources.push_back(from); });
+		std::sort(sources.begin(), sources.end(), [this](node_id const a, node_id const b) {
+			return node_less(a, b);
+		});
+		return sources;
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::is_node(N const& value) const -> bool {
-		// NOLINTNEXTLINE
-		for (auto node : node_list_) {
-			if (*node == value) {
-				return true;
-			}
-		}
-		return false;
+		return locate_node(value) != no_node;
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::is_connected(N const& src, N const& dst) const -> bool {
-		if (is_node(src) == false || is_node(dst) == false) {
+		auto const from = locate_node(src);
+		auto const to = locate_node(dst);
+		if (from == no_node || to == no_node) {
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst node "
 			                         "don't exist in the graph");
 		}
-		for (auto it = begin(); it != end(); ++it) {
-			if ((*it).from == src && (*it).to == dst) {
-				return true;
-			}
-		}
-		return false;
+		auto const [first, last] = edge_range(from, to);
+		return first != last;
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::nodes() const -> std::vector<N> {
 		auto vec = std::vector<N>{};
-		for (auto node : node_list_) {
-			vec.push_back(*node);
+		for (auto const id : nodes_->list) {
+			vec.push_back(value_of(id));
 		}
 		return vec;
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::weights(N const& src, N const& dst) const -> std::vector<E> {
-		if (is_node(src) == false || is_node(dst) == false) {
+		auto const from = locate_node(src);
+		auto const to = locate_node(dst);
+		if (from == no_node || to == no_node) {
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node don't "
 			                         "exist "
 			                         "in the graph");
 		}
 
+		auto const [first, last] = edge_range(from, to);
 		auto vec = std::vector<E>{};
-		for (auto it = begin(); it != end(); ++it) {
-			if ((*it).from == src && (*it).to == dst) {
-				vec.push_back((*it).weight);
-			}
+		vec.reserve(static_cast<std::size_t>(last - first));
+		for (auto it = first; it != last; ++it) {
+			vec.push_back(weight_of(it->weight));
 		}
 		return vec;
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::connections(N const& src) const -> std::vector<N> {
-		if (is_node(src) == false) {
+		auto const from = locate_node(src);
+		if (from == no_node) {
 			throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't exist "
 			                         "in the graph");
 		}
-		auto s = std::set<N>{};
-		for (auto it = begin(); it != end(); ++it) {
-			if ((*it).from == src) {
-				s.insert((*it).to);
-			}
+		auto const view = connection_view{*this, edges_of(from)};
+		return std::vector<N>(view.begin(), view.end());
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::connections_view(N const& src) const -> connection_view {
+		auto const from = locate_node(src);
+		if (from == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections_view if src doesn't "
+			                         "exist in the graph");
 		}
+		return connection_view{*this, edges_of(from)};
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::in_connections(N const& dst) const -> std::vector<N> {
+		auto const to = locate_node(dst);
+		if (to == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_connections if dst doesn't "
+			                         "exist in the graph");
+		}
+		auto const sources = sorted_sources(to);
 		auto vec = std::vector<N>{};
-		vec.assign(s.begin(), s.end());
+		vec.reserve(sources.size());
+		for (auto const from : sources) {
+			vec.push_back(value_of(from));
+		}
+		return vec;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::in_edges(N const& dst) const -> std::vector<edge_reference> {
+		auto const to = locate_node(dst);
+		if (to == no_node) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_edges if dst doesn't exist in "
+			                         "the graph");
+		}
+		auto const sources = sorted_sources(to);
+		auto vec = std::vector<edge_reference>{};
+		for (auto const from : sources) {
+			auto const [first, last] = edge_range(from, to);
+			for (auto it = first; it != last; ++it) {
+				vec.push_back(
+				   edge_reference{value_of(from), value_of(to), weight_of(it->weight)});
+			}
+		}
 		return vec;
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::find(N const& src, N const& dst, E const& weight) const
 	   -> iterator {
-		for (auto i = begin(); i != end(); ++i) {
-			if ((*i).from == src && (*i).to == dst && (*i).weight == weight) {
-				return i;
-			}
+		auto const from = locate_node(src);
+		auto const to = locate_node(dst);
+		if (from == no_node || to == no_node) {
+			return end();
 		}
-		return end();
+		auto const key = edge_key{to, weight};
+		auto const pos = edge_bound(from, key);
+		if (pos == edges_of(from).end() || key_before(key, *pos)) {
+			return end();
+		}
+		return iterator{*this, node_bound(src), pos};
 	}
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::operator==(graph const& other) const -> bool {
-		if (node_list_.size() != other.node_list_.size() || adj_list_.size() != other.adj_list_.size())
-		{
+		if (nodes_->list.size() != other.nodes_->list.size()) {
 			return false;
 		}
-		for (auto i = node_list_.begin(), j = other.node_list_.begin(); i != node_list_.end(); ++i, ++j)
+		for (auto i = nodes_->list.begin(), j = other.nodes_->list.begin(); i != nodes_->list.end(); ++i, ++j)
 		{
-			if (**i != **j) {
+			auto const& edges = edges_of(*i);
+			auto const& other_edges = other.edges_of(*j);
+			if (value_of(*i) != other.value_of(*j) || edges.size() != other_edges.size()) {
 				return false;
 			}
+			for (auto e = edges.begin(), f = other_edges.begin(); e != edges.end(); ++e, ++f) {
+				if (value_of(e->to) != other.value_of(f->to)
+				    || weight_of(e->weight) != other.weight_of(f->weight))
+				{
+					return false;
+				}
+			}
 		}
+		return true;
+	}
 
-		for (auto i = adj_list_.begin(), j = other.adj_list_.begin(); i != adj_list_.end(); ++i, ++j) {
-			if (*std::get<0>(*i) != *std::get<0>(*j) || *std::get<1>(*i) != *std::get<1>(*j)
-			    || *std::get<2>(*i) != *std::get<2>(*j))
-			{
-				return false;
+	// Read-only compressed sparse row (CSR) copy of a graph<N, E>, for read-mostly workloads.
+	//
+	// Nodes are stored contiguously in sorted order and referred to by their position. The
+	// out-edges of node i are the entries [offsets_[i], offsets_[i + 1]) of destinations_ and
+	// weights_, sorted by destination then weight, so queries are a binary search over nodes_
+	// followed by a binary search within one row, with no pointer chasing. Iteration visits edges
+	// in the same order as graph<N, E>. Use thaw() to get a mutable graph back.
+	template<typename N, typename E>
+	class frozen_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+
+		class iterator {
+		public:
+			using value_type = frozen_graph::value_type;
+			using reference = typename graph<N, E>::edge_reference;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return reference{graph_->nodes_[source_],
+				                 graph_->nodes_[graph_->destinations_[edge_]],
+				                 graph_->weights_[edge_]};
+			}
+			auto operator++() -> iterator& {
+				++edge_;
+				while (source_ < graph_->nodes_.size() && graph_->offsets_[source_ + 1] <= edge_) {
+					++source_;
+				}
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto copy = *this;
+				++*this;
+				return copy;
+			}
+			auto operator--() -> iterator& {
+				--edge_;
+				while (graph_->offsets_[source_] > edge_) {
+					--source_;
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto copy = *this;
+				--*this;
+				return copy;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				return graph_ == other.graph_ && edge_ == other.edge_;
+			}
+
+		private:
+			friend class frozen_graph;
+			iterator(frozen_graph const* g, std::size_t source, std::size_t edge)
+			: graph_{g}
+			, source_{source}
+			, edge_{edge} {}
+
+			frozen_graph const* graph_ = nullptr;
+			// Row containing edge_, or nodes_.size() at the end
+			std::size_t source_ = 0;
+			std::size_t edge_ = 0;
+		};
+
+		frozen_graph() = default;
+		explicit frozen_graph(graph<N, E> const& g);
+
+		[[nodiscard]] auto operator==(frozen_graph const& other) const -> bool = default;
+
+		// Mutable copy of this snapshot; operator== equal to the graph it was frozen from.
+		[[nodiscard]] auto thaw() const -> graph<N, E>;
+
+		// Accessors, with the same behaviour and exceptions as their graph<N, E> counterparts
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return index_of(value) != nodes_.size();
+		}
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty();
+		}
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool;
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return nodes_;
+		}
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E>;
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator;
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N>;
+
+		// Iterator access
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator{this, row_of(0), 0};
+		}
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator{this, nodes_.size(), destinations_.size()};
+		}
+
+	private:
+		using node_index_type = std::uint32_t;
+
+		std::vector<N> nodes_{};
+		// offsets_[i]..offsets_[i + 1] is the row of node i; always nodes_.size() + 1 entries
+		std::vector<std::size_t> offsets_{0};
+		std::vector<node_index_type> destinations_{};
+		std::vector<E> weights_{};
+
+		// Position of value in nodes_, or nodes_.size() if it is not a node
+		auto index_of(N const& value) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			return it != nodes_.end() && *it == value ? static_cast<std::size_t>(it - nodes_.begin())
+			                                          : nodes_.size();
+		}
+		// Row containing edge, or nodes_.size() if there is no such edge
+		auto row_of(std::size_t const edge) const -> std::size_t {
+			auto const it = std::upper_bound(offsets_.begin() + 1, offsets_.end(), edge);
+			return static_cast<std::size_t>(it - offsets_.begin() - 1);
+		}
+		// Edges of src going to dst, as [first, last) positions in destinations_/weights_
+		auto edge_range(std::size_t src, std::size_t dst) const
+		   -> std::pair<std::size_t, std::size_t>;
+	};
+
+	template<typename N, typename E>
+	auto graph<N, E>::freeze() const -> frozen_graph<N, E> {
+		return frozen_graph<N, E>{*this};
+	}
+
+	template<typename N, typename E>
+	frozen_graph<N, E>::frozen_graph(graph<N, E> const& g) {
+		auto positions = std::vector<node_index_type>(g.nodes_->values.id_limit());
+		nodes_.reserve(g.nodes_->list.size());
+		for (auto const id : g.nodes_->list) {
+			positions[id] = static_cast<node_index_type>(nodes_.size());
+			nodes_.push_back(g.value_of(id));
+		}
+
+		auto edge_count = std::size_t{0};
+		for (auto const id : g.nodes_->list) {
+			edge_count += g.edges_of(id).size();
+		}
+		offsets_.reserve(nodes_.size() + 1);
+		destinations_.reserve(edge_count);
+		weights_.reserve(edge_count);
+		// Each bucket is already sorted by destination, so it becomes its row as is.
+		for (auto const id : g.nodes_->list) {
+			for (auto const& e : g.edges_of(id)) {
+				destinations_.push_back(positions[e.to]);
+				weights_.push_back(g.weight_of(e.weight));
 			}
+			offsets_.push_back(destinations_.size());
 		}
-		return true;
+	}
+
+	template<typename N, typename E>
+	auto frozen_graph<N, E>::thaw() const -> graph<N, E> {
+		auto g = graph<N, E>(nodes_.begin(), nodes_.end());
+		g.insert_edges(begin(), end());
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto frozen_graph<N, E>::edge_range(std::size_t const src, std::size_t const dst) const
+	   -> std::pair<std::size_t, std::size_t> {
+		auto const row_begin = destinations_.begin() + static_cast<std::ptrdiff_t>(offsets_[src]);
+		auto const row_end = destinations_.begin() + static_cast<std::ptrdiff_t>(offsets_[src + 1]);
+		auto const [first, last] = std::equal_range(row_begin, row_end, dst);
+		return {static_cast<std::size_t>(first - destinations_.begin()),
+		        static_cast<std::size_t>(last - destinations_.begin())};
+	}
+
+	template<typename N, typename E>
+	auto frozen_graph<N, E>::is_connected(N const& src, N const& dst) const -> bool {
+		auto const from = index_of(src);
+		auto const to = index_of(dst);
+		if (from == nodes_.size() || to == nodes_.size()) {
+			throw std::runtime_error("Cannot call gdwg::frozen_graph<N, E>::is_connected if src or dst "
+			                         "node don't exist in the graph");
+		}
+		auto const [first, last] = edge_range(from, to);
+		return first != last;
+	}
+
+	template<typename N, typename E>
+	auto frozen_graph<N, E>::weights(N const& src, N const& dst) const -> std::vector<E> {
+		auto const from = index_of(src);
+		auto const to = index_of(dst);
+		if (from == nodes_.size() || to == nodes_.size()) {
+			throw std::runtime_error("Cannot call gdwg::frozen_graph<N, E>::weights if src or dst node "
+			                         "don't exist in the graph");
+		}
+		auto const [first, last] = edge_range(from, to);
+		return std::vector<E>(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+		                      weights_.begin() + static_cast<std::ptrdiff_t>(last));
+	}
+
+	template<typename N, typename E>
+	auto frozen_graph<N, E>::find(N const& src, N const& dst, E const& weight) const -> iterator {
+		auto const from = index_of(src);
+		auto const to = index_of(dst);
+		if (from == nodes_.size() || to == nodes_.size()) {
+			return end();
+		}
+		auto const [first, last] = edge_range(from, to);
+		auto const it = std::lower_bound(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+		                                 weights_.begin() + static_cast<std::ptrdiff_t>(last),
+		                                 weight);
+		auto const edge = static_cast<std::size_t>(it - weights_.begin());
+		if (edge == last || !(*it == weight)) {
+			return end();
+		}
+		return iterator{this, from, edge};
+	}
+
+	template<typename N, typename E>
+	auto frozen_graph<N, E>::connections(N const& src) const -> std::vector<N> {
+		auto const from = index_of(src);
+		if (from == nodes_.size()) {
+			throw std::runtime_error("Cannot call gdwg::frozen_graph<N, E>::connections if src doesn't "
+			                         "exist in the graph");
+		}
+		auto vec = std::vector<N>{};
+		for (auto edge = offsets_[from]; edge != offsets_[from + 1]; ++edge) {
+			if (edge == offsets_[from] || destinations_[edge] != destinations_[edge - 1]) {
+				vec.push_back(nodes_[destinations_[edge]]);
+			}
+		}
+		return vec;
 	}
 
 } // namespace gdwg
@@ -0,0 +1,298 @@
+#ifndef GDWG_GRAPH_READER_HPP
+#define GDWG_GRAPH_READER_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Text formats read by read_into and read_graph.
+	//   graph     - what operator<< writes: a line "node (" for each node, then a line
+	//               "  to | weight" for each of its out-edges, then a line ")". Node values may
+	//               contain spaces; a line is split into to and weight at its first " | ".
+	//   edge_list - a line "src dst weight" for each edge, separated by spaces or tabs, so values
+	//               cannot contain them. Every endpoint becomes a node.
+	// Blank lines are skipped and a trailing '\r' is ignored in both.
+	enum class text_format { graph, edge_list };
+
+	namespace detail {
+		// Splits a stream into lines, reading it in chunks so only one chunk (or one line, if a
+		// line is longer) is held at a time.
+		class line_reader {
+		public:
+			explicit line_reader(std::istream& in)
+			: in_{&in} {}
+
+			// The next line without its '\n', valid until the next call, or false at the end
+			auto next(std::string_view& line) -> bool {
+				while (true) {
+					auto const end = std::find(buffer_.begin() + static_cast<std::ptrdiff_t>(start_),
+					                           buffer_.end(),
+					                           '\n');
+					if (end != buffer_.end()) {
+						line = std::string_view(buffer_.data() + start_,
+						                        static_cast<std::size_t>(end - buffer_.begin()) - start_);
+						start_ = static_cast<std::size_t>(end - buffer_.begin()) + 1;
+						return true;
+					}
+					if (!fill()) {
+						if (start_ == buffer_.size()) {
+							return false;
+						}
+						line = std::string_view(buffer_.data() + start_, buffer_.size() - start_);
+						start_ = buffer_.size();
+						return true;
+					}
+				}
+			}
+
+		private:
+			static constexpr std::size_t chunk_size = std::size_t{1} << 20U;
+
+			std::istream* in_;
+			std::vector<char> buffer_{};
+			// Start of the unread part of buffer_
+			std::size_t start_ = 0;
+
+			// Drops the lines already returned and appends the next chunk; false at the end
+			auto fill() -> bool {
+				if (!*in_ || in_->eof()) {
+					return false;
+				}
+				buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(start_));
+				start_ = 0;
+				auto const kept = buffer_.size();
+				buffer_.resize(kept + chunk_size);
+				in_->read(buffer_.data() + kept, static_cast<std::streamsize>(chunk_size));
+				buffer_.resize(kept + static_cast<std::size_t>(in_->gcount()));
+				// A short read sets failbit as well, but reaching the end is how reading succeeds.
+				if (in_->eof()) {
+					in_->clear(std::ios::eofbit);
+				}
+				return buffer_.size() != kept;
+			}
+		};
+
+		// Splits a buffer already in memory into lines.
+		class buffer_line_reader {
+		public:
+			explicit buffer_line_reader(std::string_view const text)
+			: text_{text} {}
+
+			auto next(std::string_view& line) -> bool {
+				if (text_.empty()) {
+					return false;
+				}
+				auto const end = std::min(text_.find('\n'), text_.size());
+				line = text_.substr(0, end);
+				text_.remove_prefix(std::min(end + 1, text_.size()));
+				return true;
+			}
+
+		private:
+			std::string_view text_;
+		};
+
+		// T parsed from the whole of text, or nothing if text is not a T
+		template<typename T>
+		auto parse_value(std::string_view const text, T& value) -> bool {
+			if constexpr (std::same_as<T, std::string>) {
+				value.assign(text);
+				return true;
+			}
+			else if constexpr (std::same_as<T, char> || std::same_as<T, signed char>
+			                   || std::same_as<T, unsigned char>) {
+				// operator<< writes character types as the character itself, not its code
+				if (text.size() != 1) {
+					return false;
+				}
+				value = static_cast<T>(text[0]);
+				return true;
+			}
+			else if constexpr (std::is_arithmetic_v<T> && !std::same_as<T, bool>) {
+				auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+				return error == std::errc{} && end == text.data() + text.size();
+			}
+			else {
+				auto in = std::istringstream(std::string(text));
+				return static_cast<bool>(in >> value) && (in >> std::ws).eof();
+			}
+		}
+
+		// Reads lines from source into g, handing them to the bulk inserts a batch at a time.
+		template<typename N, typename E, typename Source>
+		class text_parser {
+		public:
+			text_parser(graph<N, E>& g, Source& source, text_format const format)
+			: graph_{&g}
+			, source_{&source}
+			, format_{format} {}
+
+			auto run() -> void {
+				auto line = std::string_view{};
+				while (source_->next(line)) {
+					++line_number_;
+					if (!line.empty() && line.back() == '\r') {
+						line.remove_suffix(1);
+					}
+					if (line.empty()) {
+						continue;
+					}
+					if (format_ == text_format::graph) {
+						parse_graph_line(line);
+					}
+					else {
+						parse_edge_line(line);
+					}
+					if (edges_.size() >= batch_size) {
+						flush();
+					}
+				}
+				if (in_node_) {
+					fail();
+				}
+				flush();
+			}
+
+		private:
+			using value_type = typename graph<N, E>::value_type;
+			static constexpr std::size_t batch_size = std::size_t{1} << 16U;
+
+			graph<N, E>* graph_;
+			Source* source_;
+			text_format format_;
+			std::size_t line_number_ = 0;
+			std::vector<N> nodes_{};
+			std::vector<value_type> edges_{};
+			// Source of the edge lines being read, in the graph format
+			N from_{};
+			bool in_node_ = false;
+			N to_{};
+			E weight_{};
+
+			auto parse_graph_line(std::string_view const line) -> void {
+				static constexpr auto open = std::string_view(" (");
+				static constexpr auto edge_indent = std::string_view("  ");
+				static constexpr auto separator = std::string_view(" | ");
+				if (!in_node_) {
+					if (!line.ends_with(open)
+					    || !parse_value(line.substr(0, line.size() - open.size()), from_))
+					{
+						fail();
+					}
+					nodes_.push_back(from_);
+					in_node_ = true;
+				}
+				else if (line == ")") {
+					in_node_ = false;
+				}
+				else {
+					auto const split = line.find(separator);
+					if (!line.starts_with(edge_indent) || split == std::string_view::npos
+					    || !parse_value(line.substr(edge_indent.size(), split - edge_indent.size()), to_)
+					    || !parse_value(line.substr(split + separator.size()), weight_))
+					{
+						fail();
+					}
+					edges_.emplace_back(from_, to_, weight_);
+				}
+			}
+
+			auto parse_edge_line(std::string_view line) -> void {
+				auto const next_field = [&line]() {
+					static constexpr auto blanks = std::string_view(" \t");
+					auto const first = std::min(line.find_first_not_of(blanks), line.size());
+					line.remove_prefix(first);
+					auto const last = std::min(line.find_first_of(blanks), line.size());
+					auto const field = line.substr(0, last);
+					line.remove_prefix(last);
+					return field;
+				};
+				auto const src = next_field();
+				auto const dst = next_field();
+				auto const weight = next_field();
+				if (!parse_value(src, from_) || !parse_value(dst, to_) || !parse_value(weight, weight_)
+				    || !next_field().empty())
+				{
+					fail();
+				}
+				edges_.emplace_back(from_, to_, weight_);
+			}
+
+			auto flush() -> void {
+				for (auto const& e : edges_) {
+					nodes_.push_back(e.from);
+					nodes_.push_back(e.to);
+				}
+				graph_->insert_nodes(nodes_.begin(), nodes_.end());
+				graph_->insert_edges(edges_.begin(), edges_.end());
+				nodes_.clear();
+				edges_.clear();
+			}
+
+			[[noreturn]] auto fail() const -> void {
+				throw std::runtime_error("Cannot call gdwg::read_into on malformed input at line "
+				                         + std::to_string(line_number_));
+			}
+		};
+	} // namespace detail
+
+	// Adds the nodes and edges in the text read from in to g. Input is read in chunks and added a
+	// batch of edges at a time through insert_nodes and insert_edges, so memory use beyond g's own
+	// does not grow with the input. Throws std::runtime_error, naming the line, on malformed input;
+	// batches before that line have already been added. Values are parsed with std::from_chars
+	// for arithmetic types, taken whole for std::string, and read with operator>> otherwise.
+	template<typename N, typename E>
+	auto read_into(graph<N, E>& g, std::istream& in, text_format const format = text_format::graph)
+	   -> void {
+		auto source = detail::line_reader(in);
+		detail::text_parser<N, E, detail::line_reader>(g, source, format).run();
+	}
+
+	// As above, parsing text in place.
+	template<typename N, typename E>
+	auto read_into(graph<N, E>& g,
+	               std::string_view const text,
+	               text_format const format = text_format::graph) -> void {
+		auto source = detail::buffer_line_reader(text);
+		detail::text_parser<N, E, detail::buffer_line_reader>(g, source, format).run();
+	}
+
+	// A new graph holding what read_into would add.
+	template<typename N, typename E, typename Input>
+	auto read_graph(Input&& input, text_format const format = text_format::graph) -> graph<N, E> {
+		auto g = graph<N, E>{};
+		read_into(g, std::forward<Input>(input), format);
+		return g;
+	}
+
+	// Replaces g with a graph read in operator<<'s format, up to the end of the stream. Sets
+	// failbit and leaves g unchanged if the input is malformed.
+	template<typename N, typename E>
+	auto operator>>(std::istream& in, graph<N, E>& g) -> std::istream& {
+		auto read = graph<N, E>{};
+		try {
+			read_into(read, in);
+		}
+		catch (std::runtime_error const&) {
+			in.setstate(std::ios::failbit);
+			return in;
+		}
+		g = std::move(read);
+		return in;
+	}
+} // namespace gdwg
+
+#endif // GDWG_GRAPH_READER_HPP
@@ -0,0 +1,550 @@
+#ifndef GDWG_MAPPED_GRAPH_HPP
+#define GDWG_MAPPED_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Maps files with POSIX mmap, so this header is only available on POSIX systems.
+#if !__has_include(<sys/mman.h>)
+#error "gdwg/mapped_graph.hpp needs POSIX mmap, which this platform does not provide"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdwg {
+	// Node and weight types the binary format can hold: trivially copyable types, stored as their
+	// bytes, and std::string.
+	template<typename T>
+	concept binary_storable = std::is_trivially_copyable_v<T> || std::same_as<T, std::string>;
+
+	namespace detail {
+		// Version 1 of the file layout, in the writer's byte order (checked on load):
+		//   header
+		//   nodes         node value table, in ascending order
+		//   offsets       std::uint64_t[node_count + 1]; node i's edges are
+		//                 [offsets[i], offsets[i + 1])
+		//   destinations  std::uint32_t[edge_count], node positions, ascending within each node
+		//   edge_weights  std::uint32_t[edge_count], positions in the weight table
+		//   weights       weight value table: each distinct weight once, in ascending order
+		// A value table is T[count] for a trivially copyable T. For std::string it is a
+		// std::uint64_t[count + 1] of offsets into the characters that follow it. Each section
+		// starts on an 8-byte boundary and the header gives its position in the file.
+		struct file_header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			// 1 for raw bytes and 2 for std::string, then sizeof the type
+			std::uint32_t node_kind;
+			std::uint32_t node_size;
+			std::uint32_t weight_kind;
+			std::uint32_t weight_size;
+			std::uint64_t node_count;
+			std::uint64_t edge_count;
+			std::uint64_t weight_count;
+			std::uint64_t nodes;
+			std::uint64_t offsets;
+			std::uint64_t destinations;
+			std::uint64_t edge_weights;
+			std::uint64_t weights;
+		};
+
+		inline constexpr auto file_magic = std::array<char, 8>{'G', 'D', 'W', 'G', 'R', 'A', 'P', 'H'};
+		inline constexpr std::uint32_t file_version = 1;
+		inline constexpr std::uint32_t file_byte_order = 0x01020304;
+
+		template<binary_storable T>
+		inline constexpr std::uint32_t value_kind = std::same_as<T, std::string> ? 2 : 1;
+
+		// The i-th U of an array in a mapped file, without assuming the array is a U[]
+		template<typename U>
+		auto load(std::byte const* const data, std::size_t const i) -> U {
+			auto bytes = std::array<std::byte, sizeof(U)>{};
+			std::memcpy(bytes.data(), data + i * sizeof(U), sizeof(U));
+			return std::bit_cast<U>(bytes);
+		}
+
+		// A value table in a mapped file. Trivially copyable values are returned by value and
+		// strings as views into the mapping.
+		template<binary_storable T>
+		class mapped_values {
+		public:
+			static constexpr bool is_string = std::same_as<T, std::string>;
+			using value_type = std::conditional_t<is_string, std::string_view, T>;
+
+			mapped_values() = default;
+			mapped_values(std::byte const* const data, std::size_t const count)
+			: data_{data}
+			, count_{count} {}
+
+			auto operator[](std::size_t const i) const -> value_type {
+				if constexpr (is_string) {
+					auto const first = load<std::uint64_t>(data_, i);
+					auto const last = load<std::uint64_t>(data_, i + 1);
+					return std::string_view(reinterpret_cast<char const*>(characters()) + first,
+					                        last - first);
+				}
+				else {
+					return load<T>(data_, i);
+				}
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return count_;
+			}
+			// Bytes taken by a table of count values at data, or more than available if it does not
+			// fit in them
+			static auto bytes(std::byte const* const data,
+			                  std::size_t const count,
+			                  std::size_t const available) -> std::size_t {
+				if constexpr (is_string) {
+					if (count >= available / sizeof(std::uint64_t)) {
+						return available + 1;
+					}
+					auto const offsets = (count + 1) * sizeof(std::uint64_t);
+					auto const characters = load<std::uint64_t>(data, count);
+					return characters > available - offsets ? available + 1 : offsets + characters;
+				}
+				else {
+					return count > available / sizeof(T) ? available + 1 : count * sizeof(T);
+				}
+			}
+
+		private:
+			std::byte const* data_ = nullptr;
+			std::size_t count_ = 0;
+
+			auto characters() const -> std::byte const* {
+				return data_ + (count_ + 1) * sizeof(std::uint64_t);
+			}
+		};
+
+		// Appends to a file through a buffer, keeping count of the bytes written.
+		class file_writer {
+		public:
+			explicit file_writer(std::filesystem::path const& path)
+			: out_{path, std::ios::binary | std::ios::trunc} {
+				if (!out_) {
+					throw std::runtime_error("Cannot call gdwg::save on a path that cannot be written");
+				}
+			}
+
+			auto write(void const* const data, std::size_t const size) -> void {
+				auto const* const bytes = static_cast<std::byte const*>(data);
+				buffer_.insert(buffer_.end(), bytes, bytes + size);
+				position_ += size;
+				if (buffer_.size() >= buffer_limit) {
+					flush();
+				}
+			}
+			template<typename U>
+			auto write(U const& value) -> void {
+				write(&value, sizeof(U));
+			}
+			// Pads to the next 8-byte boundary and returns it
+			auto align() -> std::uint64_t {
+				static constexpr auto zeros = std::array<std::byte, 8>{};
+				write(zeros.data(), (8 - position_ % 8) % 8);
+				return position_;
+			}
+			// Writes the buffer out and then size bytes of data at the start of the file
+			auto finish(void const* const data, std::size_t const size) -> void {
+				flush();
+				out_.seekp(0);
+				out_.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+				out_.flush();
+				if (!out_) {
+					throw std::runtime_error("Cannot call gdwg::save: writing the file failed");
+				}
+			}
+
+		private:
+			static constexpr std::size_t buffer_limit = std::size_t{1} << 20U;
+
+			std::ofstream out_;
+			std::vector<std::byte> buffer_{};
+			std::uint64_t position_ = 0;
+
+			auto flush() -> void {
+				out_.write(reinterpret_cast<char const*>(buffer_.data()),
+				           static_cast<std::streamsize>(buffer_.size()));
+				buffer_.clear();
+			}
+		};
+
+		// Writes a value table of count values, the i-th being value(i)
+		template<binary_storable T, typename F>
+		auto write_values(file_writer& out, std::size_t const count, F value) -> void {
+			if constexpr (std::same_as<T, std::string>) {
+				auto offset = std::uint64_t{0};
+				out.write(offset);
+				for (auto i = std::size_t{0}; i < count; ++i) {
+					offset += value(i).size();
+					out.write(offset);
+				}
+				for (auto i = std::size_t{0}; i < count; ++i) {
+					auto const& s = value(i);
+					out.write(s.data(), s.size());
+				}
+			}
+			else {
+				for (auto i = std::size_t{0}; i < count; ++i) {
+					out.write(value(i));
+				}
+			}
+		}
+
+		template<typename N, typename E>
+		struct graph_file {
+			static auto save(graph<N, E> const& g, std::filesystem::path const& path) -> void;
+		};
+
+		template<typename N, typename E>
+		auto graph_file<N, E>::save(graph<N, E> const& g, std::filesystem::path const& path)
+		   -> void {
+			auto const& list = g.nodes_->list;
+			auto header = file_header{};
+			header.magic = file_magic;
+			header.version = file_version;
+			header.byte_order = file_byte_order;
+			header.node_kind = value_kind<N>;
+			header.node_size = sizeof(N);
+			header.weight_kind = value_kind<E>;
+			header.weight_size = sizeof(E);
+			header.node_count = list.size();
+
+			auto out = file_writer(path);
+			out.write(header);
+
+			header.nodes = out.align();
+			write_values<N>(out, list.size(), [&](std::size_t const i) -> N const& {
+				return g.value_of(list[i]);
+			});
+
+			// Edges go in graph order, so rows and the edges within them are already sorted.
+			auto positions = std::vector<std::uint32_t>(g.nodes_->values.id_limit());
+			auto weights = std::vector<E const*>{};
+			header.offsets = out.align();
+			out.write(std::uint64_t{0});
+			for (auto i = std::size_t{0}; i < list.size(); ++i) {
+				positions[list[i]] = static_cast<std::uint32_t>(i);
+				for (auto const& e : g.edges_of(list[i])) {
+					weights.push_back(&g.weight_of(e.weight));
+				}
+				out.write(std::uint64_t{weights.size()});
+			}
+			header.edge_count = weights.size();
+
+			header.destinations = out.align();
+			for (auto const id : list) {
+				for (auto const& e : g.edges_of(id)) {
+					out.write(positions[e.to]);
+				}
+			}
+
+			auto distinct = weights;
+			auto const less = [](E const* a, E const* b) { return *a < *b; };
+			std::sort(distinct.begin(), distinct.end(), less);
+			distinct.erase(std::unique(distinct.begin(),
+			                           distinct.end(),
+			                           [](E const* a, E const* b) { return *a == *b; }),
+			               distinct.end());
+			header.weight_count = distinct.size();
+			header.edge_weights = out.align();
+			for (auto const* const w : weights) {
+				auto const it = std::lower_bound(distinct.begin(), distinct.end(), w, less);
+				out.write(static_cast<std::uint32_t>(it - distinct.begin()));
+			}
+
+			header.weights = out.align();
+			write_values<E>(out, distinct.size(), [&](std::size_t const i) -> E const& {
+				return *distinct[i];
+			});
+			out.finish(&header, sizeof(header));
+		}
+
+		// A whole file mapped read-only into memory with POSIX mmap.
+		class file_mapping {
+		public:
+			file_mapping() = default;
+			explicit file_mapping(std::filesystem::path const& path) {
+				auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+				if (fd < 0) {
+					throw std::runtime_error("Cannot call gdwg::mapped_graph on a file that cannot be "
+					                         "opened");
+				}
+				struct ::stat info {};
+				if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+					size_ = static_cast<std::size_t>(info.st_size);
+					data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+				}
+				::close(fd);
+				if (data_ == MAP_FAILED || data_ == nullptr) {
+					data_ = nullptr;
+					throw std::runtime_error("Cannot call gdwg::mapped_graph on a file that cannot be "
+					                         "mapped");
+				}
+			}
+			file_mapping(file_mapping&& other) noexcept
+			: data_{std::exchange(other.data_, nullptr)}
+			, size_{std::exchange(other.size_, 0)} {}
+			auto operator=(file_mapping&& other) noexcept -> file_mapping& {
+				std::swap(data_, other.data_);
+				std::swap(size_, other.size_);
+				return *this;
+			}
+			~file_mapping() {
+				if (data_ != nullptr) {
+					::munmap(data_, size_);
+				}
+			}
+
+			[[nodiscard]] auto data() const noexcept -> std::byte const* {
+				return static_cast<std::byte const*>(data_);
+			}
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return size_;
+			}
+
+		private:
+			void* data_ = nullptr;
+			std::size_t size_ = 0;
+		};
+	} // namespace detail
+
+	// Writes g to path in gdwg's binary graph format, replacing any file there. Open the file
+	// again with mapped_graph or load. Node and weight values are stored as their bytes (or
+	// characters, for std::string), so a file can only be read back on a machine with the same
+	// byte order and as the same graph<N, E> type.
+	template<binary_storable N, binary_storable E>
+	auto save(graph<N, E> const& g, std::filesystem::path const& path) -> void {
+		detail::graph_file<N, E>::save(g, path);
+	}
+
+	// Read-only graph served straight from a file written by save(), which is memory-mapped rather
+	// than read in: opening takes time independent of the graph's size, and pages are loaded as
+	// queries touch them. Lookups are binary searches over the node table and then within a node's
+	// edges, like frozen_graph. Strings are compared in place in the mapping.
+	//
+	// Opening checks the header and that every section fits in the file, but not the contents of
+	// the sections, so only open files written by save(). POSIX only.
+	template<binary_storable N, binary_storable E>
+	class mapped_graph {
+	public:
+		explicit mapped_graph(std::filesystem::path const& path);
+
+		// Accessors, with the same behaviour and exceptions as their graph<N, E> counterparts
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return index_of(value) != nodes_.size();
+		}
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.size() == 0;
+		}
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool;
+		[[nodiscard]] auto nodes() const -> std::vector<N>;
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E>;
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N>;
+
+		// Reads the whole file into a mutable graph
+		[[nodiscard]] auto thaw() const -> graph<N, E>;
+
+	private:
+		detail::file_mapping file_;
+		detail::mapped_values<N> nodes_{};
+		std::byte const* offsets_ = nullptr;
+		std::byte const* destinations_ = nullptr;
+		std::byte const* edge_weights_ = nullptr;
+		detail::mapped_values<E> weights_{};
+
+		// Position of value in nodes_, or nodes_.size() if it is not a node
+		auto index_of(N const& value) const -> std::size_t;
+		auto row_begin(std::size_t const node) const -> std::size_t {
+			return detail::load<std::uint64_t>(offsets_, node);
+		}
+		auto destination(std::size_t const edge) const -> std::size_t {
+			return detail::load<std::uint32_t>(destinations_, edge);
+		}
+		// Edges of src going to dst, as [first, last) edge positions
+		auto edge_range(std::size_t src, std::size_t dst) const
+		   -> std::pair<std::size_t, std::size_t>;
+	};
+
+	// Reads a file written by save() into a graph.
+	template<binary_storable N, binary_storable E>
+	auto load(std::filesystem::path const& path) -> graph<N, E> {
+		return mapped_graph<N, E>(path).thaw();
+	}
+
+	template<binary_storable N, binary_storable E>
+	mapped_graph<N, E>::mapped_graph(std::filesystem::path const& path)
+	: file_{path} {
+		auto const* const data = file_.data();
+		auto const size = file_.size();
+		auto header = detail::file_header{};
+		if (size < sizeof(header)) {
+			throw std::runtime_error("Cannot call gdwg::mapped_graph on a file that is not a graph");
+		}
+		std::memcpy(&header, data, sizeof(header));
+		if (header.magic != detail::file_magic || header.byte_order != detail::file_byte_order) {
+			throw std::runtime_error("Cannot call gdwg::mapped_graph on a file that is not a graph");
+		}
+		if (header.version != detail::file_version) {
+			throw std::runtime_error("Cannot call gdwg::mapped_graph on a graph file of an "
+			                         "unsupported version");
+		}
+		if (header.node_kind != detail::value_kind<N> || header.node_size != sizeof(N)
+		    || header.weight_kind != detail::value_kind<E> || header.weight_size != sizeof(E))
+		{
+			throw std::runtime_error("Cannot call gdwg::mapped_graph on a graph file of a different "
+			                         "graph<N, E> type");
+		}
+
+		// Each section must lie within the file. Counts are bounded by the bytes left after their
+		// section's offset before they are multiplied, so a huge count cannot wrap to a small size,
+		// and offsets are checked before any pointer is formed from them.
+		auto const truncated = [] {
+			return std::runtime_error("Cannot call gdwg::mapped_graph on a graph file that is "
+			                          "truncated");
+		};
+		auto const available = [size](std::uint64_t const offset) -> std::size_t {
+			return offset <= size ? size - offset : 0;
+		};
+		if (header.nodes > size || header.weights > size) {
+			throw truncated();
+		}
+		auto const node_bytes = detail::mapped_values<N>::bytes(data + header.nodes,
+		                                                        header.node_count,
+		                                                        available(header.nodes));
+		auto const weight_bytes = detail::mapped_values<E>::bytes(data + header.weights,
+		                                                          header.weight_count,
+		                                                          available(header.weights));
+		auto const edges = header.edge_count;
+		if (node_bytes > available(header.nodes) || weight_bytes > available(header.weights)
+		    || header.offsets > size
+		    || header.node_count >= available(header.offsets) / sizeof(std::uint64_t)
+		    || header.destinations > size
+		    || edges > available(header.destinations) / sizeof(std::uint32_t)
+		    || header.edge_weights > size
+		    || edges > available(header.edge_weights) / sizeof(std::uint32_t))
+		{
+			throw truncated();
+		}
+		nodes_ = detail::mapped_values<N>(data + header.nodes, header.node_count);
+		offsets_ = data + header.offsets;
+		destinations_ = data + header.destinations;
+		edge_weights_ = data + header.edge_weights;
+		weights_ = detail::mapped_values<E>(data + header.weights, header.weight_count);
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::index_of(N const& value) const -> std::size_t {
+		auto const positions = std::views::iota(std::size_t{0}, nodes_.size());
+		auto const it = std::ranges::partition_point(positions, [&](std::size_t const i) {
+			return nodes_[i] < value;
+		});
+		return it != positions.end() && nodes_[*it] == value ? *it : nodes_.size();
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::edge_range(std::size_t const src, std::size_t const dst) const
+	   -> std::pair<std::size_t, std::size_t> {
+		auto const begin = row_begin(src);
+		auto const row = std::views::iota(begin, row_begin(src + 1));
+		auto const project = [this](std::size_t const edge) { return destination(edge); };
+		auto const first = std::ranges::lower_bound(row, dst, {}, project);
+		auto const last = std::ranges::upper_bound(first, row.end(), dst, {}, project);
+		return {begin + static_cast<std::size_t>(first - row.begin()),
+		        begin + static_cast<std::size_t>(last - row.begin())};
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::is_connected(N const& src, N const& dst) const -> bool {
+		auto const from = index_of(src);
+		auto const to = index_of(dst);
+		if (from == nodes_.size() || to == nodes_.size()) {
+			throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::is_connected if src or dst "
+			                         "node don't exist in the graph");
+		}
+		auto const [first, last] = edge_range(from, to);
+		return first != last;
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::nodes() const -> std::vector<N> {
+		auto vec = std::vector<N>{};
+		vec.reserve(nodes_.size());
+		for (auto i = std::size_t{0}; i < nodes_.size(); ++i) {
+			vec.emplace_back(nodes_[i]);
+		}
+		return vec;
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::weights(N const& src, N const& dst) const -> std::vector<E> {
+		auto const from = index_of(src);
+		auto const to = index_of(dst);
+		if (from == nodes_.size() || to == nodes_.size()) {
+			throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::weights if src or dst node "
+			                         "don't exist in the graph");
+		}
+		auto const [first, last] = edge_range(from, to);
+		auto vec = std::vector<E>{};
+		vec.reserve(last - first);
+		for (auto edge = first; edge != last; ++edge) {
+			vec.emplace_back(weights_[detail::load<std::uint32_t>(edge_weights_, edge)]);
+		}
+		return vec;
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::connections(N const& src) const -> std::vector<N> {
+		auto const from = index_of(src);
+		if (from == nodes_.size()) {
+			throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::connections if src doesn't "
+			                         "exist in the graph");
+		}
+		auto vec = std::vector<N>{};
+		for (auto edge = row_begin(from); edge != row_begin(from + 1); ++edge) {
+			if (edge == row_begin(from) || destination(edge) != destination(edge - 1)) {
+				vec.emplace_back(nodes_[destination(edge)]);
+			}
+		}
+		return vec;
+	}
+
+	template<binary_storable N, binary_storable E>
+	auto mapped_graph<N, E>::thaw() const -> graph<N, E> {
+		auto const values = nodes();
+		auto g = graph<N, E>(values.begin(), values.end());
+		auto edges = std::vector<typename graph<N, E>::value_type>{};
+		edges.reserve(row_begin(nodes_.size()));
+		for (auto from = std::size_t{0}; from < nodes_.size(); ++from) {
+			for (auto edge = row_begin(from); edge != row_begin(from + 1); ++edge) {
+				edges.emplace_back(values[from],
+				                   values[destination(edge)],
+				                   E(weights_[detail::load<std::uint32_t>(edge_weights_, edge)]));
+			}
+		}
+		g.insert_edges(edges.begin(), edges.end());
+		return g;
+	}
+} // namespace gdwg
+
+#endif // GDWG_MAPPED_GRAPH_HPP
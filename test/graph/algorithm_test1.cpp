@@ -0,0 +1,538 @@
+#include "gdwg/algorithm.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Runs the same weights through the 4-ary heap, for comparison with the radix heap ints get.
+template<>
+inline constexpr auto gdwg::shortest_path_heap_for<long> = gdwg::shortest_path_heap::d_ary;
+// Leaves out the reverse index that bottom-up search steps use.
+template<>
+inline constexpr auto gdwg::edge_index_for<int, short> = gdwg::edge_index::outgoing;
+
+namespace {
+	// Distances from src by Bellman-Ford over the graph's public interface, nothing where there is
+	// no path
+	template<typename N, typename E>
+	auto reference_distances(gdwg::graph<N, E> const& g, N const& src)
+	   -> std::vector<std::optional<E>> {
+		auto const nodes = g.nodes();
+		auto const index = [&](N const& value) {
+			return static_cast<std::size_t>(std::lower_bound(nodes.begin(), nodes.end(), value)
+			                                - nodes.begin());
+		};
+		auto distances = std::vector<std::optional<E>>(nodes.size());
+		distances[index(src)] = E{};
+		for (auto round = std::size_t{0}; round < nodes.size(); ++round) {
+			for (auto const& e : g) {
+				auto const& from = distances[index(e.from)];
+				auto& to = distances[index(e.to)];
+				if (from && (!to || *from + e.weight < *to)) {
+					to = static_cast<E>(*from + e.weight);
+				}
+			}
+		}
+		return distances;
+	}
+
+	template<typename E>
+	auto random_graph(unsigned const seed) -> gdwg::graph<int, E> {
+		auto engine = std::mt19937{seed};
+		auto node = std::uniform_int_distribution<int>(0, 59);
+		auto weight = std::uniform_int_distribution<int>(0, 40);
+		auto g = gdwg::graph<int, E>{};
+		for (auto i = 0; i < 60; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 150; ++i) {
+			g.insert_edge(node(engine), node(engine), static_cast<E>(weight(engine)) / E{2});
+		}
+		return g;
+	}
+} // namespace
+
+TEST_CASE("Shortest paths") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "lonely"};
+	g.insert_edge("a", "b", 7);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("c", "b", 3);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("c", "d", 9);
+	g.insert_edge("d", "e", 0);
+	g.insert_edge("e", "a", 1);
+	auto const paths = gdwg::shortest_paths(g, std::string("a"));
+
+	SECTION("Distances and predecessors") {
+		CHECK(paths.source() == "a");
+		CHECK(paths.distance("a") == 0);
+		CHECK(paths.distance("b") == 5);
+		CHECK(paths.distance("d") == 6);
+		CHECK(paths.distance("e") == 6);
+		CHECK(paths.predecessor("b") == "c");
+		CHECK(paths.predecessor("a") == std::nullopt);
+		CHECK(paths.path_to("e") == std::vector<std::string>{"a", "c", "b", "d", "e"});
+		CHECK(paths.path_to("a") == std::vector<std::string>{"a"});
+	}
+
+	SECTION("Unreachable nodes") {
+		CHECK(!paths.is_reachable("lonely"));
+		CHECK(paths.distance("lonely") == std::nullopt);
+		CHECK(paths.predecessor("lonely") == std::nullopt);
+		CHECK(paths.path_to("lonely").empty());
+	}
+
+	SECTION("Independent of the graph once built") {
+		g.clear();
+		CHECK(paths.distance("e") == 6);
+	}
+
+	SECTION("Throws on missing nodes and negative weights") {
+		CHECK_THROWS_AS(gdwg::shortest_paths(g, std::string("missing")), std::runtime_error);
+		CHECK_THROWS_WITH(paths.distance("missing"),
+		                  "Cannot call gdwg::shortest_path_tree<N, E>::distance if dst doesn't "
+		                  "exist in the graph");
+		g.insert_edge("lonely", "a", -1);
+		CHECK_THROWS_WITH(gdwg::shortest_paths(g, std::string("a")),
+		                  "Cannot call gdwg::shortest_paths on a graph with negative weights");
+	}
+}
+
+TEMPLATE_TEST_CASE("Shortest paths match Bellman-Ford", "", int, long, double) {
+	// int takes the radix heap; long and double the 4-ary heap
+	for (auto seed = 1U; seed <= 5; ++seed) {
+		auto const g = random_graph<TestType>(seed);
+		for (auto const src : {0, 17, 59}) {
+			auto const paths = gdwg::shortest_paths(g, src);
+			auto const expected = reference_distances(g, src);
+			for (auto const node : g.nodes()) {
+				auto const distance = paths.distance(node);
+				REQUIRE(distance == expected[static_cast<std::size_t>(node)]);
+				// The path found adds up to the distance.
+				auto const path = paths.path_to(node);
+				auto length = TestType{};
+				for (auto i = std::size_t{1}; i < path.size(); ++i) {
+					auto const weights = g.weights(path[i - 1], path[i]);
+					REQUIRE(!weights.empty());
+					length += weights.front();
+				}
+				CHECK(path.empty() == !distance);
+				if (distance) {
+					CHECK(length == *distance);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Breadth-first search") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "lonely"};
+	g.insert_edge("a", "b", 7);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("c", "d", 3);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("d", "e", 9);
+	g.insert_edge("e", "a", 1);
+	g.insert_edge("lonely", "a", 1);
+	auto const tree = gdwg::bfs(g, std::string("a"));
+
+	SECTION("Hops and parents") {
+		CHECK(tree.source() == "a");
+		CHECK(tree.hops("a") == 0);
+		CHECK(tree.hops("d") == 2);
+		CHECK(tree.hops("e") == 3);
+		CHECK(tree.parent("b") == "a");
+		CHECK(tree.parent("a") == std::nullopt);
+		auto const path = tree.path_to("e");
+		CHECK(path.size() == 4);
+		CHECK(path.front() == "a");
+		CHECK(path.back() == "e");
+	}
+
+	SECTION("Unreachable nodes") {
+		CHECK(!tree.is_reachable("lonely"));
+		CHECK(tree.hops("lonely") == std::nullopt);
+		CHECK(tree.path_to("lonely").empty());
+	}
+
+	SECTION("Reachability") {
+		CHECK(gdwg::reachable(g, std::string("lonely"), std::string("e")));
+		CHECK(gdwg::reachable(g, std::string("a"), std::string("a")));
+		CHECK(!gdwg::reachable(g, std::string("a"), std::string("lonely")));
+	}
+
+	SECTION("Throws on missing nodes") {
+		CHECK_THROWS_AS(gdwg::bfs(g, std::string("missing")), std::runtime_error);
+		CHECK_THROWS_AS(gdwg::reachable(g, std::string("a"), std::string("missing")),
+		                std::runtime_error);
+		CHECK_THROWS_WITH(tree.hops("missing"),
+		                  "Cannot call gdwg::bfs_tree<N>::hops if dst doesn't exist in the graph");
+	}
+}
+
+TEMPLATE_TEST_CASE("Breadth-first search matches a queue", "", int, short) {
+	// Big and dense enough for the frontier to go bottom-up for a few levels. short weights leave
+	// out the reverse index, so every level goes top-down.
+	constexpr auto node_count = 4000;
+	auto engine = std::mt19937{6771};
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	auto g = gdwg::graph<int, TestType>{};
+	for (auto i = 0; i < node_count; ++i) {
+		g.insert_node(i);
+	}
+	auto edges = std::vector<typename gdwg::graph<int, TestType>::value_type>{};
+	for (auto i = 0; i < 8 * node_count; ++i) {
+		edges.emplace_back(node(engine), node(engine), TestType{1});
+	}
+	g.insert_edges(edges.begin(), edges.end());
+	// Leave some ids unused
+	for (auto i = 0; i < node_count; i += 37) {
+		g.erase_node(i);
+	}
+
+	auto const src = 1;
+	auto expected = std::map<int, std::size_t>{{src, 0}};
+	auto queue = std::vector<int>{src};
+	for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+		for (auto const next : g.connections(queue[i])) {
+			if (expected.emplace(next, expected[queue[i]] + 1).second) {
+				queue.push_back(next);
+			}
+		}
+	}
+
+	for (auto const threads : {1, 2, 4}) {
+		auto const tree = gdwg::bfs(g, src, static_cast<std::size_t>(threads));
+		for (auto const n : g.nodes()) {
+			auto const it = expected.find(n);
+			auto const hops = tree.hops(n);
+			REQUIRE(hops == (it == expected.end() ? std::nullopt : std::optional(it->second)));
+			if (hops && n != src) {
+				auto const parent = *tree.parent(n);
+				CHECK(g.is_connected(parent, n));
+				CHECK(tree.hops(parent) == *hops - 1);
+			}
+		}
+		CHECK(gdwg::reachable(g, src, queue.back(), static_cast<std::size_t>(threads)));
+	}
+}
+
+TEST_CASE("Strongly connected components") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f", "lonely"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("b", "d", 2);
+	g.insert_edge("d", "e", 1);
+	g.insert_edge("e", "d", 1);
+	g.insert_edge("e", "f", 1);
+	g.insert_edge("f", "f", 1);
+	auto const components = gdwg::strongly_connected_components(g);
+
+	SECTION("Components in topological order") {
+		CHECK(components.size() == 4);
+		CHECK(components.component_of("a") == components.component_of("c"));
+		CHECK(components.component_of("d") == components.component_of("e"));
+		CHECK(components.component_of("a") < components.component_of("d"));
+		CHECK(components.component_of("e") < components.component_of("f"));
+		CHECK(components.members(components.component_of("b"))
+		      == std::vector<std::string>{"a", "b", "c"});
+		CHECK(components.members(components.component_of("lonely"))
+		      == std::vector<std::string>{"lonely"});
+	}
+
+	SECTION("Independent of the graph once built") {
+		g.clear();
+		CHECK(components.members(components.component_of("f")) == std::vector<std::string>{"f"});
+	}
+
+	SECTION("Condensation") {
+		auto const dag = gdwg::condensation(g);
+		auto const abc = components.component_of("a");
+		auto const de = components.component_of("d");
+		auto const f = components.component_of("f");
+		CHECK(dag.nodes().size() == 4);
+		CHECK(dag.weights(abc, de) == std::vector<std::size_t>{2});
+		CHECK(dag.weights(de, f) == std::vector<std::size_t>{1});
+		CHECK(dag.connections(f).empty());
+		CHECK_NOTHROW(gdwg::topological_order(dag));
+	}
+
+	SECTION("Topological order") {
+		CHECK_THROWS_WITH(gdwg::topological_order(g),
+		                  "Cannot call gdwg::topological_order on a graph with a cycle");
+		auto dag = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		dag.insert_edge(4, 2, 1);
+		dag.insert_edge(2, 1, 1);
+		dag.insert_edge(4, 1, 1);
+		dag.insert_edge(5, 3, 1);
+		auto const order = gdwg::topological_order(dag);
+		REQUIRE(order.size() == 5);
+		for (auto const& e : dag) {
+			CHECK(std::find(order.begin(), order.end(), e.from)
+			      < std::find(order.begin(), order.end(), e.to));
+		}
+		dag.insert_edge(3, 3, 1);
+		CHECK_THROWS_AS(gdwg::topological_order(dag), std::runtime_error);
+	}
+
+	SECTION("Throws on missing nodes and components") {
+		CHECK_THROWS_WITH(components.component_of("missing"),
+		                  "Cannot call gdwg::component_map<N>::component_of if value doesn't "
+		                  "exist in the graph");
+		CHECK_THROWS_AS(components.members(4), std::runtime_error);
+	}
+}
+
+TEST_CASE("Strongly connected components of long paths") {
+	// Deep enough to overflow the call stack of a recursive search
+	constexpr auto node_count = 300'000;
+	auto nodes = std::vector<int>(node_count);
+	auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+	for (auto i = 0; i < node_count; ++i) {
+		nodes[static_cast<std::size_t>(i)] = i;
+		if (i + 1 < node_count) {
+			edges.emplace_back(i, i + 1, 1);
+		}
+	}
+	auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+	g.insert_edges(edges.begin(), edges.end());
+
+	auto const order = gdwg::topological_order(g);
+	CHECK(order == nodes);
+	CHECK(gdwg::strongly_connected_components(g).size() == node_count);
+
+	// Closing the path makes one component of it.
+	g.insert_edge(node_count - 1, 0, 1);
+	auto const components = gdwg::strongly_connected_components(g);
+	CHECK(components.size() == 1);
+	CHECK(components.members(0) == nodes);
+}
+
+TEST_CASE("Strongly connected components match mutual reachability") {
+	for (auto seed = 1U; seed <= 5; ++seed) {
+		auto const g = random_graph<int>(seed);
+		auto const components = gdwg::strongly_connected_components(g);
+		auto const nodes = g.nodes();
+		for (auto const a : nodes) {
+			for (auto const b : nodes) {
+				auto const both = gdwg::reachable(g, a, b) && gdwg::reachable(g, b, a);
+				REQUIRE(both == (components.component_of(a) == components.component_of(b)));
+			}
+		}
+		for (auto const& e : g) {
+			CHECK(components.component_of(e.from) <= components.component_of(e.to));
+		}
+	}
+}
+
+TEST_CASE("PageRank") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "a", 1);
+
+	SECTION("A cycle ranks every node alike") {
+		auto const ranks = gdwg::pagerank(g);
+		CHECK(ranks.converged());
+		CHECK(ranks.score("a") == Approx(1.0 / 3));
+		CHECK(ranks.score("c") == Approx(1.0 / 3));
+	}
+
+	SECTION("Nodes without out-edges share their score") {
+		// b has no out-edges, so its score goes to a, b and c alike, and everything else to b.
+		g.erase_edge("b", "c", 1);
+		g.erase_edge("c", "a", 1);
+		g.insert_edge("a", "b", 2);
+		g.insert_edge("c", "b", 1);
+		auto const ranks = gdwg::pagerank(g, {.tolerance = 1e-14});
+		auto const a = ranks.score("a");
+		auto const b = ranks.score("b");
+		CHECK(ranks.converged());
+		CHECK(ranks.score("c") == Approx(a));
+		CHECK(a + b + ranks.score("c") == Approx(1.0));
+		CHECK(a == Approx(0.05 + 0.85 * b / 3));
+		CHECK(b == Approx(0.05 + 0.85 * (2 * a + b / 3)));
+	}
+
+	SECTION("Stops after max_iterations") {
+		auto const ranks = gdwg::pagerank(g, {.max_iterations = 0});
+		CHECK(ranks.iterations() == 0);
+		CHECK(!ranks.converged());
+		CHECK(ranks.score("b") == 1.0 / 3);
+	}
+
+	SECTION("Independent of the graph once built") {
+		auto const ranks = gdwg::pagerank(g);
+		g.clear();
+		CHECK(ranks.score("a") == Approx(1.0 / 3));
+		CHECK(gdwg::pagerank(g).converged());
+	}
+
+	SECTION("Throws on missing nodes and bad damping") {
+		CHECK_THROWS_WITH(gdwg::pagerank(g, {.damping = 1.5}),
+		                  "Cannot call gdwg::pagerank with a damping outside [0, 1]");
+		CHECK_THROWS_WITH(gdwg::pagerank(g).score("missing"),
+		                  "Cannot call gdwg::pagerank_scores<N>::score if value doesn't exist in "
+		                  "the graph");
+	}
+}
+
+TEST_CASE("PageRank matches power iteration") {
+	// Enough nodes for four threads, a tenth of them without out-edges
+	constexpr auto node_count = 20'000;
+	auto engine = std::mt19937{6771};
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	auto nodes = std::vector<int>(node_count);
+	auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+	for (auto i = 0; i < node_count; ++i) {
+		nodes[static_cast<std::size_t>(i)] = i;
+		for (auto k = 0; i % 10 != 0 && k < 6; ++k) {
+			edges.emplace_back(i, node(engine), 1);
+		}
+	}
+	auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+	g.insert_edges(edges.begin(), edges.end());
+
+	auto out_degrees = std::vector<double>(node_count);
+	for (auto const& e : g) {
+		out_degrees[static_cast<std::size_t>(e.from)] += 1;
+	}
+	auto expected = std::vector<double>(node_count, 1.0 / node_count);
+	for (auto round = 0; round < 100; ++round) {
+		auto dangling = 0.0;
+		for (auto i = std::size_t{0}; i < expected.size(); ++i) {
+			dangling += out_degrees[i] == 0 ? expected[i] : 0;
+		}
+		auto next = std::vector<double>(node_count, (0.15 + 0.85 * dangling) / node_count);
+		for (auto const& e : g) {
+			auto const from = static_cast<std::size_t>(e.from);
+			next[static_cast<std::size_t>(e.to)] += 0.85 * expected[from] / out_degrees[from];
+		}
+		expected = std::move(next);
+	}
+
+	for (auto const threads : {1, 2, 4}) {
+		auto const ranks = gdwg::pagerank(g, {.threads = static_cast<std::size_t>(threads)});
+		CHECK(ranks.converged());
+		auto total = 0.0;
+		for (auto const n : nodes) {
+			REQUIRE(ranks.score(n) == Approx(expected[static_cast<std::size_t>(n)]).epsilon(1e-8));
+			total += ranks.score(n);
+		}
+		CHECK(total == Approx(1.0));
+	}
+}
+
+TEST_CASE("Minimum spanning forest") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f", "lonely"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("a", "c", 3);
+	g.insert_edge("c", "b", 2);
+	g.insert_edge("b", "d", 5);
+	g.insert_edge("d", "d", -9);
+	g.insert_edge("e", "f", 7);
+	g.insert_edge("f", "e", 7);
+
+	for (auto const threads : {1, 2}) {
+		auto const forest = gdwg::minimum_spanning_forest(g, static_cast<std::size_t>(threads));
+		// Edges come in graph order; of the two equal e-f edges the first is kept, and the
+		// self-loop never is.
+		REQUIRE(forest.size() == 4);
+		CHECK((forest[0].from == "b" && forest[0].to == "a" && forest[0].weight == 1));
+		CHECK((forest[1].from == "b" && forest[1].to == "d" && forest[1].weight == 5));
+		CHECK((forest[2].from == "c" && forest[2].to == "b" && forest[2].weight == 2));
+		CHECK((forest[3].from == "e" && forest[3].to == "f" && forest[3].weight == 7));
+	}
+	CHECK(gdwg::minimum_spanning_forest(gdwg::graph<int, int>{}).empty());
+}
+
+TEST_CASE("Weakly connected components") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "lonely"};
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("c", "b", 1);
+	g.insert_edge("e", "d", 1);
+	g.insert_edge("d", "d", 1);
+	auto const components = gdwg::weakly_connected_components(g);
+
+	// Numbered in order of their least node
+	CHECK(components.size() == 3);
+	CHECK(components.members(0) == std::vector<std::string>{"a", "b", "c"});
+	CHECK(components.members(1) == std::vector<std::string>{"d", "e"});
+	CHECK(components.component_of("lonely") == 2);
+	CHECK(gdwg::weakly_connected_components(gdwg::graph<int, int>{}).size() == 0);
+}
+
+TEMPLATE_TEST_CASE("Minimum spanning forests agree", "", int, double) {
+	// Few distinct weights, so many tie
+	constexpr auto node_count = 20'000;
+	auto engine = std::mt19937{6771};
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	auto weight = std::uniform_int_distribution<int>(-5, 20);
+	auto nodes = std::vector<int>(node_count);
+	auto edges = std::vector<typename gdwg::graph<int, TestType>::value_type>{};
+	for (auto i = 0; i < node_count; ++i) {
+		nodes[static_cast<std::size_t>(i)] = i;
+	}
+	for (auto i = 0; i < node_count * 3 / 2; ++i) {
+		edges.emplace_back(node(engine), node(engine), static_cast<TestType>(weight(engine)));
+	}
+	auto g = gdwg::graph<int, TestType>(nodes.begin(), nodes.end());
+	g.insert_edges(edges.begin(), edges.end());
+
+	// Kruskal's over copies of the edges, with a plain union-find
+	auto sorted = std::vector<typename gdwg::graph<int, TestType>::value_type>(g.begin(), g.end());
+	std::stable_sort(sorted.begin(), sorted.end(), [](auto const& a, auto const& b) {
+		return a.weight < b.weight;
+	});
+	auto parents = nodes;
+	auto const root = [&](int x) {
+		while (parents[static_cast<std::size_t>(x)] != x) {
+			x = parents[static_cast<std::size_t>(x)];
+		}
+		return x;
+	};
+	auto expected_weight = TestType{};
+	auto expected_edges = std::size_t{0};
+	for (auto const& e : sorted) {
+		auto const a = root(e.from);
+		auto const b = root(e.to);
+		if (a != b) {
+			parents[static_cast<std::size_t>(a)] = b;
+			expected_weight += e.weight;
+			++expected_edges;
+		}
+	}
+
+	auto const components = gdwg::weakly_connected_components(g);
+	CHECK(components.size() == nodes.size() - expected_edges);
+	for (auto const& e : g) {
+		REQUIRE(components.component_of(e.from) == components.component_of(e.to));
+	}
+
+	auto const kruskal = gdwg::minimum_spanning_forest(g, 1);
+	REQUIRE(kruskal.size() == expected_edges);
+	auto total = TestType{};
+	for (auto const& e : kruskal) {
+		total += e.weight;
+		CHECK(g.is_connected(e.from, e.to));
+	}
+	CHECK(total == expected_weight);
+	for (auto const threads : {2, 4}) {
+		auto const boruvka = gdwg::minimum_spanning_forest(g, static_cast<std::size_t>(threads));
+		REQUIRE(boruvka.size() == kruskal.size());
+		for (auto i = std::size_t{0}; i < kruskal.size(); ++i) {
+			REQUIRE(boruvka[i].from == kruskal[i].from);
+			REQUIRE(boruvka[i].to == kruskal[i].to);
+			REQUIRE(boruvka[i].weight == kruskal[i].weight);
+		}
+	}
+}
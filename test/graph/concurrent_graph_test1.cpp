@@ -0,0 +1,140 @@
+#include "gdwg/concurrent_graph.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writers copy the current version on every change, which copy_on_write makes O(1).
+template<>
+inline constexpr auto gdwg::copy_mode_for<int, int> = gdwg::copy_mode::copy_on_write;
+
+TEST_CASE("Concurrent graph") {
+	auto g = gdwg::concurrent_graph<std::string, int>{gdwg::graph<std::string, int>{"a", "b"}};
+
+	SECTION("Forwards reads and writes to the current version") {
+		CHECK(g.insert_node("c"));
+		CHECK(!g.insert_node("c"));
+		CHECK(g.insert_edge("a", "b", 1));
+		CHECK(g.insert_edge("a", "c", 2));
+		CHECK(g.is_connected("a", "b"));
+		CHECK(g.connections("a") == std::vector<std::string>{"b", "c"});
+		CHECK(g.in_connections("c") == std::vector<std::string>{"a"});
+		CHECK(g.erase_edge("a", "b", 1));
+		CHECK(g.weights("a", "b").empty());
+		CHECK(g.replace_node("c", "d"));
+		CHECK(g.erase_node("d"));
+		CHECK(g.nodes() == std::vector<std::string>{"a", "b"});
+		g.clear();
+		CHECK(g.empty());
+	}
+
+	SECTION("A read handle keeps its version") {
+		auto const before = g.read();
+		CHECK(g.insert_edge("a", "b", 1));
+		CHECK(g.erase_node("b"));
+		CHECK(before->nodes() == std::vector<std::string>{"a", "b"});
+		CHECK(!before->is_connected("a", "b"));
+		CHECK(g.snapshot() != *before);
+	}
+
+	SECTION("update publishes a batch at once, or nothing if it throws or returns false") {
+		auto const added = g.update([](gdwg::graph<std::string, int>& h) {
+			h.insert_edge("a", "b", 1);
+			h.insert_edge("b", "a", 1);
+			return 2;
+		});
+		CHECK(added == 2);
+		CHECK(g.is_connected("b", "a"));
+		CHECK_THROWS_AS(g.update([](gdwg::graph<std::string, int>& h) {
+			                h.erase_node("a");
+			                h.insert_edge("x", "b", 1);
+		                }),
+		                std::runtime_error);
+		CHECK(g.is_node("a"));
+		CHECK(!g.update([](gdwg::graph<std::string, int>& h) {
+			h.erase_node("b");
+			return false;
+		}));
+		CHECK(g.is_node("b"));
+	}
+}
+
+TEST_CASE("Concurrent graph readers always see whole changes") {
+	// The writer only ever adds or removes an edge together with its reverse, in one update, so a
+	// reader that sees one without the other has seen half a change.
+	constexpr auto node_count = 64;
+	constexpr auto reader_count = 4;
+	auto initial = gdwg::graph<int, int>{};
+	for (auto i = 0; i < node_count; ++i) {
+		initial.insert_node(i);
+	}
+	auto g = gdwg::concurrent_graph<int, int>{initial};
+	auto done = std::atomic<bool>{false};
+	auto failures = std::atomic<int>{0};
+	auto reads = std::atomic<int>{0};
+
+	auto readers = std::vector<std::thread>{};
+	for (auto r = 0; r < reader_count; ++r) {
+		readers.emplace_back([&, r] {
+			auto engine = std::mt19937{static_cast<std::mt19937::result_type>(r)};
+			auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+			while (!done.load()) {
+				auto const version = g.read();
+				auto const a = node(engine);
+				auto const b = node(engine);
+				if (version->is_connected(a, b) != version->is_connected(b, a)) {
+					++failures;
+				}
+				auto edges = std::size_t{0};
+				for (auto const& e : *version) {
+					edges += e.from == e.to ? 2 : 1;
+				}
+				if (edges % 2 != 0) {
+					++failures;
+				}
+				++reads;
+			}
+		});
+	}
+
+	auto engine = std::mt19937{6771};
+	auto node = std::uniform_int_distribution<int>(0, node_count - 1);
+	for (auto step = 0; step < 2000; ++step) {
+		auto const a = node(engine);
+		auto const b = node(engine);
+		g.update([a, b](gdwg::graph<int, int>& h) {
+			if (h.is_connected(a, b)) {
+				h.erase_edge(a, b, 0);
+				if (a != b) {
+					h.erase_edge(b, a, 0);
+				}
+			}
+			else {
+				h.insert_edge(a, b, 0);
+				h.insert_edge(b, a, 0);
+			}
+		});
+	}
+	// Keep going until every reader has had a chance to run against a changing graph.
+	while (reads.load() < reader_count * 100) {
+		g.update([&](gdwg::graph<int, int>& h) {
+			auto const a = node(engine);
+			return h.insert_edge(a, a, 1) || h.erase_edge(a, a, 1);
+		});
+	}
+	done = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+
+	CHECK(failures.load() == 0);
+	auto const last = g.snapshot();
+	for (auto const& e : last) {
+		CHECK(last.is_connected(e.to, e.from));
+	}
+}
@@ -0,0 +1,130 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"hello", "goodbye", "hi", "lonely"};
+		g.insert_edge("hello", "goodbye", 2);
+		g.insert_edge("hello", "goodbye", 3);
+		g.insert_edge("goodbye", "hello", 8);
+		g.insert_edge("hello", "hi", 4);
+		g.insert_edge("goodbye", "goodbye", 5);
+		g.insert_edge("hi", "hi", 1);
+		return g;
+	}
+
+	template<typename G>
+	auto edges_of(G const& g) -> std::vector<std::tuple<std::string, std::string, int>> {
+		auto edges = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			edges.emplace_back(from, to, weight);
+		}
+		return edges;
+	}
+} // namespace
+
+TEST_CASE("FREEZE") {
+	auto const g = make_graph();
+	auto const frozen = g.freeze();
+
+	SECTION("Same nodes") {
+		CHECK(frozen.nodes() == g.nodes());
+		CHECK(frozen.is_node("lonely"));
+		CHECK(frozen.is_node("lol") == false);
+		CHECK(frozen.empty() == false);
+	}
+	SECTION("Same edges in the same order") {
+		CHECK(edges_of(frozen) == edges_of(g));
+	}
+	SECTION("Empty graph") {
+		auto const empty = gdwg::graph<std::string, int>{}.freeze();
+		CHECK(empty.empty());
+		CHECK(empty.begin() == empty.end());
+	}
+	SECTION("Graph with nodes but no edges") {
+		auto const nodes_only = gdwg::graph<std::string, int>{"a", "b"}.freeze();
+		CHECK(nodes_only.begin() == nodes_only.end());
+		CHECK(nodes_only.connections("a").empty());
+	}
+}
+
+TEST_CASE("FROZEN ACCESSORS") {
+	auto const g = make_graph();
+	auto const frozen = g.freeze();
+
+	SECTION("is_connected") {
+		CHECK(frozen.is_connected("hello", "hi"));
+		CHECK(frozen.is_connected("goodbye", "hi") == false);
+		CHECK(frozen.is_connected("hi", "hello") == false);
+		CHECK_THROWS_WITH(frozen.is_connected("a", "hi"),
+		                  "Cannot call gdwg::frozen_graph<N, E>::is_connected if src or dst node "
+		                  "don't exist in the graph");
+	}
+	SECTION("weights") {
+		CHECK(frozen.weights("hello", "goodbye") == std::vector<int>{2, 3});
+		CHECK(frozen.weights("hello", "hello").empty());
+		CHECK(frozen.weights("goodbye", "goodbye") == std::vector<int>{5});
+		CHECK_THROWS_WITH(frozen.weights("hello", "b"),
+		                  "Cannot call gdwg::frozen_graph<N, E>::weights if src or dst node don't "
+		                  "exist in the graph");
+	}
+	SECTION("find") {
+		auto const it = frozen.find("hello", "goodbye", 3);
+		REQUIRE(it != frozen.end());
+		CHECK(((*it).from == "hello" && (*it).to == "goodbye" && (*it).weight == 3));
+		CHECK(((*std::next(it)).from == "hello" && (*std::next(it)).to == "hi"));
+		CHECK(frozen.find("hello", "goodbye", 5) == frozen.end());
+		CHECK(frozen.find("lol", "ok", 5) == frozen.end());
+	}
+	SECTION("connections") {
+		CHECK(frozen.connections("hello") == std::vector<std::string>{"goodbye", "hi"});
+		CHECK(frozen.connections("goodbye") == std::vector<std::string>{"goodbye", "hello"});
+		CHECK(frozen.connections("lonely").empty());
+		CHECK_THROWS_WITH(frozen.connections("lol"),
+		                  "Cannot call gdwg::frozen_graph<N, E>::connections if src doesn't exist "
+		                  "in the graph");
+	}
+}
+
+TEST_CASE("FROZEN ITERATOR") {
+	auto const frozen = make_graph().freeze();
+
+	SECTION("Walks backwards from end") {
+		auto it = frozen.end();
+		--it;
+		CHECK(((*it).from == "hi" && (*it).to == "hi" && (*it).weight == 1));
+		it--;
+		CHECK(((*it).from == "hello" && (*it).to == "hi" && (*it).weight == 4));
+		auto count = 1;
+		while (it != frozen.begin()) {
+			--it;
+			++count;
+		}
+		CHECK(count == 5);
+		CHECK(((*it).from == "goodbye" && (*it).to == "goodbye" && (*it).weight == 5));
+	}
+	SECTION("Refers to the stored values") {
+		auto const& [from, to, weight] = *frozen.begin();
+		CHECK(&from == &(*frozen.find("goodbye", "goodbye", 5)).from);
+		CHECK(&from == &to);
+		CHECK(weight == 5);
+	}
+	SECTION("Iterators of different snapshots are not equal") {
+		auto const other = make_graph().freeze();
+		CHECK(frozen.begin() != other.begin());
+		CHECK(frozen == other);
+	}
+}
+
+TEST_CASE("THAW") {
+	auto const g = make_graph();
+	auto thawed = g.freeze().thaw();
+	CHECK(thawed == g);
+	CHECK(thawed.insert_edge("lonely", "hello", 1));
+	CHECK(thawed.is_connected("lonely", "hello"));
+}
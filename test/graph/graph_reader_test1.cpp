@@ -0,0 +1,131 @@
+#include "gdwg/graph_reader.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"hello", "goodbye", "hi there", "lonely"};
+		g.insert_edge("hello", "goodbye", 2);
+		g.insert_edge("hello", "goodbye", 3);
+		g.insert_edge("goodbye", "hello", -8);
+		g.insert_edge("hello", "hi there", 4);
+		g.insert_edge("goodbye", "goodbye", 5);
+		g.insert_edge("hi there", "hi there", 1);
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto to_text(gdwg::graph<N, E> const& g) -> std::string {
+		auto out = std::ostringstream{};
+		out << g;
+		return out.str();
+	}
+} // namespace
+
+TEST_CASE("Reading back what operator<< writes") {
+	auto const g = make_graph();
+	auto const text = to_text(g);
+
+	SECTION("From a stream or a buffer") {
+		auto in = std::istringstream(text);
+		CHECK(gdwg::read_graph<std::string, int>(in) == g);
+		CHECK(gdwg::read_graph<std::string, int>(std::string_view(text)) == g);
+	}
+
+	SECTION("With operator>>") {
+		auto in = std::istringstream(text);
+		auto read = gdwg::graph<std::string, int>{"replaced"};
+		CHECK(in >> read);
+		CHECK(read == g);
+	}
+
+	SECTION("With Windows line endings and blank lines") {
+		auto crlf = std::string{};
+		for (auto const c : text) {
+			crlf += c == '\n' ? std::string("\r\n\r\n") : std::string(1, c);
+		}
+		CHECK(gdwg::read_graph<std::string, int>(std::string_view(crlf)) == g);
+	}
+
+	SECTION("Into a graph that already has nodes and edges") {
+		auto h = gdwg::graph<std::string, int>{"other", "hello"};
+		h.insert_edge("other", "hello", 7);
+		gdwg::read_into(h, std::string_view(text));
+		CHECK(h.nodes() == std::vector<std::string>{"goodbye", "hello", "hi there", "lonely", "other"});
+		CHECK(h.is_connected("other", "hello"));
+		CHECK(h.weights("hello", "goodbye") == std::vector<int>{2, 3});
+	}
+}
+
+TEST_CASE("Reading back character nodes and weights") {
+	auto g = gdwg::graph<char, int>{'a', 'b'};
+	g.insert_edge('a', 'b', 1);
+	auto const text = to_text(g);
+	CHECK(gdwg::read_graph<char, int>(std::string_view(text)) == g);
+	auto in = std::istringstream(text);
+	auto read = gdwg::graph<char, int>{};
+	CHECK(in >> read);
+	CHECK(read == g);
+
+	auto h = gdwg::graph<int, unsigned char>{1, 2};
+	h.insert_edge(1, 2, static_cast<unsigned char>('x'));
+	CHECK(gdwg::read_graph<int, unsigned char>(std::string_view(to_text(h))) == h);
+}
+
+TEST_CASE("Reading large inputs in batches") {
+	// More edges than one batch and more text than one chunk of the stream reader
+	auto g = gdwg::graph<int, double>{};
+	for (auto i = 0; i < 2000; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < 2000; ++i) {
+		for (auto j = 0; j < 50; ++j) {
+			g.insert_edge(i, (i * 7 + j * 13) % 2000, j * 0.5);
+		}
+	}
+	auto in = std::istringstream(to_text(g));
+	CHECK(in.str().size() > std::size_t{1} << 20U);
+	CHECK(gdwg::read_graph<int, double>(in) == g);
+}
+
+TEST_CASE("Reading an edge list") {
+	auto const text = std::string("1 2 0.5\n"
+	                              "  2\t1   1.5  \n"
+	                              "\n"
+	                              "3 3 -2\n"
+	                              "1 2 0.5");
+	auto const g = gdwg::read_graph<int, double>(std::string_view(text), gdwg::text_format::edge_list);
+	CHECK(g.nodes() == std::vector<int>{1, 2, 3});
+	CHECK(g.weights(1, 2) == std::vector<double>{0.5});
+	CHECK(g.weights(2, 1) == std::vector<double>{1.5});
+	CHECK(g.weights(3, 3) == std::vector<double>{-2});
+}
+
+TEST_CASE("Malformed input") {
+	auto const read = [](std::string const& text, gdwg::text_format format) {
+		return gdwg::read_graph<int, int>(std::string_view(text), format);
+	};
+	using enum gdwg::text_format;
+
+	SECTION("Throws naming the line") {
+		CHECK_THROWS_WITH(read("1 (\n  2 | x\n)\n", graph),
+		                  "Cannot call gdwg::read_into on malformed input at line 2");
+		CHECK_THROWS_AS(read("1\n", graph), std::runtime_error);
+		CHECK_THROWS_AS(read("1 (\n2 | 3\n)\n", graph), std::runtime_error);
+		CHECK_THROWS_AS(read("1 (\n  2 | 3\n", graph), std::runtime_error);
+		CHECK_THROWS_AS(read("1 2\n", edge_list), std::runtime_error);
+		CHECK_THROWS_AS(read("1 2 3 4\n", edge_list), std::runtime_error);
+		CHECK_THROWS_AS(read("1 2 3x\n", edge_list), std::runtime_error);
+	}
+
+	SECTION("operator>> sets failbit and leaves the graph alone") {
+		auto in = std::istringstream("1 (\n  oops\n)\n");
+		auto g = gdwg::graph<int, int>{5};
+		CHECK(!(in >> g));
+		CHECK(g.nodes() == std::vector<int>{5});
+	}
+}
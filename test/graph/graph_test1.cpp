@@ -1,9 +1,59 @@
 #include "gdwg/graph.hpp"
 
+#include <algorithm>
 #include <catch2/catch.hpp>
+#include <functional>
 #include <initializer_list>
+#include <map>
 #include <memory>
+#include <optional>
+#include <random>
+#include <set>
 #include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	// Node type that opts out of the hashed node index.
+	struct ordered_node {
+		int value;
+		auto operator<=>(ordered_node const&) const = default;
+	};
+
+	// Weight type with no std::hash, so it is interned through the sorted index.
+	struct ordered_weight {
+		int value;
+		auto operator<=>(ordered_weight const&) const = default;
+	};
+
+	// Scalar weight forced back into the pool.
+	enum class interned_weight : int {};
+
+	template<typename W>
+	auto make_weight(int const value) -> W {
+		if constexpr (std::is_same_v<W, std::string>) {
+			return std::to_string(value);
+		}
+		else {
+			return W{value};
+		}
+	}
+} // namespace
+
+template<>
+inline constexpr auto gdwg::node_index_for<ordered_node> = gdwg::node_index::ordered;
+template<>
+inline constexpr auto gdwg::weight_storage_for<interned_weight> = gdwg::weight_storage::interned;
+// Leaves one instantiation of the reference model test without the reverse edge index.
+template<>
+inline constexpr auto gdwg::edge_index_for<int, ordered_weight> = gdwg::edge_index::outgoing;
+// Shares storage between copies, for the snapshot tests and two reference model instantiations.
+template<>
+inline constexpr auto gdwg::copy_mode_for<int, std::string> = gdwg::copy_mode::copy_on_write;
+template<>
+inline constexpr auto gdwg::copy_mode_for<int, interned_weight> = gdwg::copy_mode::copy_on_write;
 
 TEST_CASE("CONSTRUCTOR - No args") {
 	SECTION("Can be instantiated and is empty") {
@@ -51,6 +101,28 @@ TEST_CASE("CONSTRUCTOR - InputIt") {
 	}
 }
 
+TEST_CASE("CONSTRUCTOR - value_type range") {
+	using graph = gdwg::graph<std::string, int>;
+	auto const edges = std::vector<graph::value_type>{
+	   {"b", "a", 2},
+	   {"a", "b", 1},
+	   {"a", "b", 1},
+	   {"c", "c", 7},
+	};
+	auto const g = graph(edges.begin(), edges.end());
+
+	SECTION("Endpoints become nodes") {
+		CHECK(g.nodes() == std::vector<std::string>{"a", "b", "c"});
+	}
+	SECTION("Same graph as inserting one edge at a time") {
+		auto incremental = graph{"a", "b", "c"};
+		for (auto const& edge : edges) {
+			incremental.insert_edge(edge);
+		}
+		CHECK(g == incremental);
+	}
+}
+
 TEST_CASE("COPY CONSTRUCTOR") {
 	auto const list = std::initializer_list<std::string>{"hello", "goodbye", "hi"};
 	auto g = gdwg::graph<std::string, int>{list};
@@ -70,6 +142,67 @@ TEST_CASE("COPY CONSTRUCTOR") {
 		CHECK(g2.find("hello", "goodbye", 3) != g.end());
 		CHECK(g2.find("hello", "hi", 4) != g.end());
 	}
+
+	SECTION("Is independent of the original") {
+		g.erase_node("goodbye");
+		g.insert_edge("hi", "hello", 2);
+		g.replace_node("hello", "a");
+		CHECK(g2.nodes() == std::vector<std::string>{"goodbye", "hello", "hi"});
+		CHECK(g2.find("hello", "goodbye", 2) != g2.end());
+		CHECK(g2.in_connections("hello").empty());
+		auto g3 = g2;
+		g3.erase_edge("hello", "goodbye", 2);
+		g3.insert_node("z");
+		CHECK(g3 != g2);
+		CHECK(g2.weights("hello", "goodbye") == std::vector<int>{2, 3});
+	}
+
+	SECTION("Copies of a graph with erased nodes stay usable") {
+		auto h = gdwg::graph<std::string, std::string>{"a", "b", "c", "d"};
+		h.insert_edge("a", "b", "x");
+		h.insert_edge("c", "b", "x");
+		h.insert_edge("d", "a", "y");
+		h.erase_node("c");
+		h.erase_edge("d", "a", "y");
+		auto copy = h;
+		CHECK(copy == h);
+		CHECK(copy.insert_node("e"));
+		CHECK(copy.insert_edge("e", "a", "y"));
+		CHECK(copy.insert_edge("e", "b", "x"));
+		CHECK(copy.in_connections("b") == std::vector<std::string>{"a", "e"});
+		CHECK(h.in_connections("b") == std::vector<std::string>{"a"});
+	}
+
+	SECTION("Copy-on-write copies only see their own changes") {
+		// Enough nodes to span several bucket chunks
+		auto h = gdwg::graph<int, std::string>{};
+		for (auto i = 0; i < 200; ++i) {
+			h.insert_node(i);
+		}
+		for (auto i = 0; i < 200; ++i) {
+			h.insert_edge(i, (i * 7) % 200, "w");
+			h.insert_edge(i, (i * 7 + 1) % 200, "v");
+		}
+		auto const original = h;
+		auto copy = h;
+
+		auto const next = copy.erase_edge(copy.find(150, 50, "w"));
+		CHECK(((*next).from == 150 && (*next).to == 51 && (*next).weight == "v"));
+		CHECK(copy.insert_edge(3, 199, "new"));
+		CHECK(copy.replace_node(0, 1000));
+		CHECK(copy.erase_node(100));
+		CHECK(h == original);
+		CHECK(h.is_connected(150, 50));
+		CHECK(h.in_connections(0) == std::vector<int>{0, 57});
+
+		h.erase_edge(h.find(1, 7, "w"));
+		CHECK(h.insert_node(-1));
+		CHECK(copy.is_connected(1, 7));
+		CHECK(!copy.is_node(-1));
+		CHECK(copy.weights(3, 199) == std::vector<std::string>{"new"});
+		CHECK(copy.in_connections(1000) == std::vector<int>{57, 1000});
+		CHECK(original.nodes().size() == 200);
+	}
 }
 
 TEST_CASE("COPY ASSIGNMENT") {
@@ -93,6 +226,18 @@ TEST_CASE("COPY ASSIGNMENT") {
 		CHECK(g2.find("hello", "goodbye", 3) != g.end());
 		CHECK(g2.find("hello", "hi", 4) != g.end());
 	}
+
+	SECTION("Replaces the previous contents") {
+		CHECK(g2 == g);
+		CHECK(g2.is_node("no") == false);
+		CHECK(g2.in_connections("hi") == std::vector<std::string>{"hello"});
+	}
+
+	SECTION("Self-assignment") {
+		auto& self = g2;
+		g2 = self;
+		CHECK(g2 == g);
+	}
 }
 
 TEST_CASE("MOVE CONSTRUCTOR") {
@@ -182,6 +327,58 @@ TEST_CASE("INSERT NODE") {
 	}
 }
 
+TEST_CASE("INSERT NODES") {
+	auto g = gdwg::graph<std::string, int>{"hello", "goodbye"};
+	auto const values = std::vector<std::string>{"hi", "hello", "abc", "hi", "zzz"};
+	CHECK(g.insert_nodes(values.begin(), values.end()) == 3);
+	CHECK(g.nodes() == std::vector<std::string>{"abc", "goodbye", "hello", "hi", "zzz"});
+	CHECK(g.is_node("abc"));
+	CHECK(g.is_node("zzz"));
+	CHECK(g.insert_nodes(values.begin(), values.end()) == 0);
+}
+
+TEST_CASE("INSERT EDGES") {
+	using graph = gdwg::graph<std::string, int>;
+	auto g = graph{"hello", "goodbye", "hi"};
+	g.insert_edge("hello", "goodbye", 2);
+	g.insert_edge("hi", "hello", 5);
+	auto const edges = std::vector<graph::value_type>{
+	   {"hi", "hi", 3},
+	   {"hello", "goodbye", 2},
+	   {"goodbye", "hello", 5},
+	   {"hello", "hi", 3},
+	   {"hi", "hi", 3},
+	   {"goodbye", "goodbye", 9},
+	};
+
+	SECTION("Same graph as inserting one edge at a time") {
+		auto incremental = g;
+		auto added = std::size_t{0};
+		for (auto const& edge : edges) {
+			added += incremental.insert_edge(edge) ? 1U : 0U;
+		}
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == added);
+		CHECK(g == incremental);
+	}
+	SECTION("Edges are iterated in order") {
+		g.insert_edges(edges.begin(), edges.end());
+		auto it = g.begin();
+		CHECK(((*it).from == "goodbye" && (*it).to == "goodbye" && (*it).weight == 9));
+		it = std::prev(g.end());
+		CHECK(((*it).from == "hi" && (*it).to == "hi" && (*it).weight == 3));
+		CHECK(g.insert_edge("hello", "hi", 3) == false);
+	}
+	SECTION("Missing endpoint throws and leaves the graph unchanged") {
+		auto const before = g;
+		auto bad = edges;
+		bad.emplace_back("hello", "lol", 1);
+		CHECK_THROWS_WITH(g.insert_edges(bad.begin(), bad.end()),
+		                  "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist in "
+		                  "the graph");
+		CHECK(g == before);
+	}
+}
+
 TEST_CASE("INSERT EDGE") {
 	auto const list = std::initializer_list<std::string>{"hello", "goodbye", "hi"};
 	auto g = gdwg::graph<std::string, int>{list};
@@ -195,6 +392,27 @@ TEST_CASE("INSERT EDGE") {
 	SECTION("Edge fails if it exists already") {
 		CHECK(g.insert_edge("hello", "goodbye", 3) == false);
 	}
+	SECTION("Edges inserted out of order are iterated in order") {
+		CHECK(g.insert_edge("hi", "hello", 1));
+		CHECK(g.insert_edge("goodbye", "hi", 9));
+		CHECK(g.insert_edge("hello", "goodbye", 1));
+		CHECK(g.insert_edge("goodbye", "hi", 0));
+		CHECK(g.insert_edge("hi", "goodbye", 2) == false);
+		auto const expected = std::vector<std::tuple<std::string, std::string, int>>{
+		   {"goodbye", "hi", 0},
+		   {"goodbye", "hi", 9},
+		   {"hello", "goodbye", 1},
+		   {"hello", "goodbye", 2},
+		   {"hello", "goodbye", 3},
+		   {"hi", "goodbye", 2},
+		   {"hi", "hello", 1},
+		};
+		auto actual = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			actual.emplace_back(from, to, weight);
+		}
+		CHECK(actual == expected);
+	}
 	SECTION("Edge exception if either node does not exist") {
 		CHECK_THROWS_WITH(g.insert_edge("lol", "hello", 3),
 		                  "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist in "
@@ -228,6 +446,17 @@ TEST_CASE("REPLACE NODE") {
 		CHECK(g.find("lol", "goodbye", 3) != g.end());
 		CHECK(g.find("lol", "hi", 4) != g.end());
 	}
+	SECTION("Replaced edges move to their ordered position") {
+		g.insert_edge("hi", "hello", 1);
+		CHECK(g.replace_node("hello", "a"));
+		auto it = g.begin();
+		CHECK(((*it).from == "a" && (*it).to == "goodbye" && (*it).weight == 2));
+		it = std::prev(g.end());
+		CHECK(((*it).from == "hi" && (*it).to == "a" && (*it).weight == 1));
+		CHECK(g.insert_edge("a", "a", 1));
+		CHECK(g.insert_edge("a", "a", 1) == false);
+		CHECK(((*g.begin()).from == "a" && (*g.begin()).to == "a"));
+	}
 }
 
 TEST_CASE("MERGE REPLACE NODE") {
@@ -272,6 +501,38 @@ TEST_CASE("MERGE REPLACE NODE") {
 		it++;
 		CHECK(((*it).from == "hello" && (*it).to == "hello" && (*it).weight == 3));
 	}
+	SECTION("Edges into and out of both nodes") {
+		g.insert_node("a");
+		g.insert_node("z");
+		g.insert_edge("a", "goodbye", 1);
+		g.insert_edge("a", "goodbye", 9);
+		g.insert_edge("a", "hello", 9);
+		g.insert_edge("z", "goodbye", 1);
+		g.insert_edge("hi", "hello", 7);
+		g.insert_edge("hi", "goodbye", 7);
+		g.insert_edge("hi", "goodbye", 6);
+		g.insert_edge("goodbye", "z", 3);
+		g.insert_edge("hello", "z", 3);
+		g.insert_edge("goodbye", "a", 2);
+		auto expected = gdwg::graph<std::string, int>{"a", "hello", "hi", "z"};
+		for (auto const& [from, to, w] : g) {
+			expected.insert_edge(from == "goodbye" ? "hello" : from, to == "goodbye" ? "hello" : to, w);
+		}
+		g.merge_replace_node("goodbye", "hello");
+		CHECK(g == expected);
+		CHECK(g.weights("a", "hello") == std::vector<int>{1, 9});
+		CHECK(g.weights("hi", "hello") == std::vector<int>{6, 7});
+		CHECK(g.in_connections("hello") == std::vector<std::string>{"a", "hello", "hi", "z"});
+		CHECK(g.in_connections("z") == std::vector<std::string>{"hello"});
+		CHECK(g.in_connections("a") == std::vector<std::string>{"hello"});
+		CHECK(g.in_connections("hi") == std::vector<std::string>{"hello"});
+		CHECK(g.connections("hello") == std::vector<std::string>{"a", "hello", "hi", "z"});
+	}
+	SECTION("Merging a node into itself changes nothing") {
+		auto const before = g;
+		g.merge_replace_node("hello", "hello");
+		CHECK(g == before);
+	}
 }
 
 TEST_CASE("ERASE NODE") {
@@ -348,6 +609,196 @@ TEST_CASE("ERASE EDGE") {
 		++it;
 		CHECK(((*it).from == "hello" && (*it).to == "hi" && (*it).weight == 4));
 	}
+
+	SECTION("erase_edge(iterator, iterator) over nodes without edges") {
+		g.insert_node("a");
+		g.insert_node("h");
+		g.insert_edge("a", "a", 1);
+		auto const next = g.erase_edge(g.begin(), g.find("hello", "goodbye", 3));
+		CHECK(next == g.begin());
+		CHECK(((*next).from == "hello" && (*next).to == "goodbye" && (*next).weight == 3));
+		CHECK(g.erase_edge(std::next(g.begin()), g.end()) == g.end());
+		CHECK(std::next(g.begin()) == g.end());
+		CHECK(g.nodes().size() == 5);
+	}
+}
+
+TEST_CASE("ERASE NODES") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("a", "d", 3);
+	g.insert_edge("a", "d", 4);
+	g.insert_edge("b", "b", 5);
+	g.insert_edge("c", "a", 6);
+	g.insert_edge("d", "e", 7);
+	g.insert_edge("e", "c", 8);
+	g.insert_edge("e", "e", 9);
+
+	SECTION("Remaining edges keep their order") {
+		auto const values = std::vector<std::string>{"d", "lol", "b", "d"};
+		CHECK(g.erase_nodes(values.begin(), values.end()) == 2);
+		CHECK(g.nodes() == std::vector<std::string>{"a", "c", "e"});
+		auto expected = gdwg::graph<std::string, int>{"a", "c", "e"};
+		expected.insert_edge("a", "c", 2);
+		expected.insert_edge("c", "a", 6);
+		expected.insert_edge("e", "c", 8);
+		expected.insert_edge("e", "e", 9);
+		CHECK(g == expected);
+		CHECK(g.in_connections("c") == std::vector<std::string>{"a", "e"});
+		CHECK(g.in_connections("e") == std::vector<std::string>{"e"});
+		CHECK(g.connections("a") == std::vector<std::string>{"c"});
+	}
+
+	SECTION("Same graph as erasing each node in turn") {
+		auto each = g;
+		each.erase_node("a");
+		each.erase_node("e");
+		auto const values = std::vector<std::string>{"e", "a"};
+		CHECK(g.erase_nodes(values.begin(), values.end()) == 2);
+		CHECK(g == each);
+		CHECK(g.in_connections("b") == std::vector<std::string>{"b"});
+		CHECK(g.in_connections("c").empty());
+	}
+
+	SECTION("Nothing to erase") {
+		auto const before = g;
+		auto const values = std::vector<std::string>{"lol"};
+		CHECK(g.erase_nodes(values.begin(), values.end()) == 0);
+		CHECK(g.erase_nodes(values.begin(), values.begin()) == 0);
+		CHECK(g == before);
+	}
+}
+
+TEST_CASE("ERASE EDGES") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c"};
+	g.insert_edge("a", "a", 1);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("b", "a", 4);
+	g.insert_edge("c", "b", 5);
+
+	CHECK(g.erase_edges("a") == 3);
+	CHECK(g.erase_edges("a") == 0);
+	CHECK(g.connections("a").empty());
+	CHECK(g.in_connections("a") == std::vector<std::string>{"b"});
+	CHECK(g.in_connections("b") == std::vector<std::string>{"c"});
+	auto it = g.begin();
+	CHECK(((*it).from == "b" && (*it).to == "a" && (*it).weight == 4));
+	++it;
+	CHECK(((*it).from == "c" && (*it).to == "b" && (*it).weight == 5));
+	CHECK(++it == g.end());
+	CHECK_THROWS_WITH(g.erase_edges("lol"),
+	                  "Cannot call gdwg::graph<N, E>::erase_edges if src doesn't exist in the graph");
+}
+
+TEST_CASE("ERASE EDGES IF") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	for (auto from = 1; from <= 3; ++from) {
+		for (auto to = 1; to <= 3; ++to) {
+			for (auto w = 0; w < 4; ++w) {
+				g.insert_edge(from, to, 10 * from + w);
+			}
+		}
+	}
+
+	SECTION("Remaining edges keep their order") {
+		auto visited = std::vector<std::tuple<int, int, int>>{};
+		auto expected = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, w] : g) {
+			visited.emplace_back(from, to, w);
+			if (w % 2 == 0 && !(from == 1 && to == 2)) {
+				expected.emplace_back(from, to, w);
+			}
+		}
+		auto seen = std::vector<std::tuple<int, int, int>>{};
+		auto const erased = g.erase_edges_if([&](auto const& e) {
+			seen.emplace_back(e.from, e.to, e.weight);
+			return e.weight % 2 == 1 || (e.from == 1 && e.to == 2);
+		});
+		CHECK(seen == visited);
+		CHECK(erased == visited.size() - expected.size());
+		auto actual = std::vector<std::tuple<int, int, int>>{};
+		for (auto const& [from, to, w] : g) {
+			actual.emplace_back(from, to, w);
+		}
+		CHECK(actual == expected);
+		CHECK(g.in_connections(2) == std::vector<int>{2, 3});
+		CHECK(g.in_connections(1) == std::vector<int>{1, 2, 3});
+	}
+
+	SECTION("Erasing a destination's edges from every source") {
+		CHECK(g.erase_edges_if([](gdwg::graph<int, int>::value_type const& e) { return e.to == 3; })
+		      == 12);
+		CHECK(g.in_connections(3).empty());
+		CHECK(g.connections(2) == std::vector<int>{1, 2});
+		CHECK(g.erase_edges_if([](auto const&) { return false; }) == 0);
+		CHECK(g.erase_edges_if([](auto const&) { return true; }) == 24);
+		CHECK(g.begin() == g.end());
+		CHECK(g.nodes() == std::vector<int>{1, 2, 3});
+	}
+}
+
+TEST_CASE("BATCH") {
+	auto const list = std::initializer_list<std::string>{"hello", "goodbye", "hi"};
+	auto g = gdwg::graph<std::string, int>{list};
+	g.insert_edge("hello", "goodbye", 2);
+	g.insert_edge("hello", "goodbye", 3);
+	g.insert_edge("goodbye", "hello", 8);
+	g.insert_edge("hello", "hi", 4);
+
+	SECTION("Same graph as making each change in turn") {
+		auto incremental = g;
+		auto batch = g.batch();
+		batch.insert_edge("hi", "hello", 1)
+		   .erase_edge("hello", "goodbye", 3)
+		   .insert_edge("hello", "goodbye", 2)
+		   .erase_edge("hello", "hi", 9)
+		   .insert_edge("goodbye", "goodbye", 5)
+		   .erase_edge("goodbye", "goodbye", 5)
+		   .erase_edge("hello", "hi", 4)
+		   .insert_edge("hello", "hi", 4)
+		   .erase_edge("goodbye", "hello", 8);
+		CHECK(batch.size() == 9);
+		incremental.insert_edge("hi", "hello", 1);
+		incremental.erase_edge("hello", "goodbye", 3);
+		incremental.erase_edge("goodbye", "hello", 8);
+		batch.commit();
+		CHECK(batch.empty());
+		CHECK(g == incremental);
+		CHECK(g.in_connections("hello") == std::vector<std::string>{"hi"});
+		CHECK(g.in_connections("goodbye") == std::vector<std::string>{"hello"});
+	}
+
+	SECTION("Nothing changes until commit") {
+		auto const before = g;
+		auto batch = g.batch();
+		batch.erase_edge("hello", "hi", 4);
+		CHECK(g == before);
+		batch = g.batch();
+		batch.commit();
+		CHECK(g == before);
+	}
+
+	SECTION("Missing endpoint throws and leaves the graph and batch unchanged") {
+		auto const before = g;
+		auto batch = g.batch();
+		batch.erase_edge("hello", "hi", 4).erase_edge("lol", "hi", 4).insert_edge("hi", "lol", 1);
+		CHECK_THROWS_WITH(batch.commit(),
+		                  "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't "
+		                  "exist in the graph");
+		CHECK(g == before);
+		CHECK(batch.size() == 3);
+		auto inserts = g.batch();
+		inserts.insert_edge("hi", "lol", 1);
+		CHECK_THROWS_WITH(inserts.commit(),
+		                  "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist in "
+		                  "the graph");
+		g.insert_node("lol");
+		batch.commit();
+		CHECK(g.is_connected("hi", "lol"));
+		CHECK(!g.is_connected("hello", "hi"));
+	}
 }
 
 TEST_CASE("CLEAR") {
@@ -384,6 +835,66 @@ TEST_CASE("is_node & empty") {
 	CHECK(g.is_node("hi") == false);
 }
 
+TEST_CASE("Node index") {
+	STATIC_REQUIRE(gdwg::node_index_for<std::string> == gdwg::node_index::hashed);
+	STATIC_REQUIRE(gdwg::node_index_for<ordered_node> == gdwg::node_index::ordered);
+
+	SECTION("Hashed index follows insert, replace and erase") {
+		auto g = gdwg::graph<std::string, int>{"hello", "goodbye", "hi"};
+		g.insert_edge("hello", "hi", 1);
+		CHECK(g.replace_node("hello", "lol"));
+		CHECK(g.is_node("lol") == true);
+		CHECK(g.is_node("hello") == false);
+		CHECK(g.is_connected("lol", "hi"));
+		CHECK(g.erase_node("lol"));
+		CHECK(g.is_node("lol") == false);
+		CHECK(g.insert_node("lol"));
+		CHECK(g.is_node("lol") == true);
+	}
+	SECTION("Ordered index follows insert, replace and erase") {
+		auto g = gdwg::graph<ordered_node, int>{{3}, {1}, {2}};
+		CHECK(g.is_node({1}) == true);
+		CHECK(g.is_node({4}) == false);
+		g.insert_edge({3}, {1}, 7);
+		CHECK(g.replace_node({3}, {0}));
+		CHECK(g.is_node({3}) == false);
+		CHECK(g.is_connected({0}, {1}));
+		CHECK(g.erase_node({1}));
+		CHECK(g.is_node({1}) == false);
+		CHECK(g.is_node({0}) == true);
+		CHECK(g.is_node({2}) == true);
+	}
+	SECTION("Moved-from and cleared graphs have no stale index entries") {
+		auto g = gdwg::graph<std::string, int>{"a", "b"};
+		auto g2 = std::move(g);
+		CHECK(g2.is_node("a") == true);
+		g2.clear();
+		CHECK(g2.is_node("a") == false);
+		CHECK(g2.insert_node("a"));
+	}
+}
+
+TEST_CASE("Weight storage") {
+	STATIC_REQUIRE(gdwg::weight_storage_for<int> == gdwg::weight_storage::direct);
+	STATIC_REQUIRE(gdwg::weight_storage_for<double> == gdwg::weight_storage::direct);
+	STATIC_REQUIRE(gdwg::weight_storage_for<std::string> == gdwg::weight_storage::interned);
+	STATIC_REQUIRE(gdwg::weight_storage_for<interned_weight> == gdwg::weight_storage::interned);
+
+	SECTION("Shared weights survive erasing some of their edges") {
+		auto g = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+		CHECK(g.insert_edge("a", "b", "shared"));
+		CHECK(g.insert_edge("b", "c", "shared"));
+		CHECK(g.insert_edge("c", "a", "shared"));
+		CHECK(g.erase_edge("a", "b", "shared"));
+		CHECK(g.erase_node("b"));
+		CHECK(g.weights("c", "a") == std::vector<std::string>{"shared"});
+		auto const next = g.erase_edge(g.begin());
+		CHECK(next == g.end());
+		CHECK(g.insert_edge("a", "c", "shared"));
+		CHECK(g.weights("a", "c") == std::vector<std::string>{"shared"});
+	}
+}
+
 TEST_CASE("Is_Connected") {
 	auto const list = std::initializer_list<std::string>{"hello", "goodbye", "hi"};
 	auto g = gdwg::graph<std::string, int>{list};
@@ -496,6 +1007,67 @@ TEST_CASE("Connections") {
 		auto const v = std::vector<std::string>{};
 		CHECK(g.connections("lol") == v);
 	}
+	SECTION("connections_view") {
+		auto const view = g.connections_view("hello");
+		CHECK(std::ranges::equal(view, std::vector<std::string>{"goodbye", "hi"}));
+		STATIC_REQUIRE(std::ranges::forward_range<decltype(view)>);
+		STATIC_REQUIRE(std::ranges::view<std::remove_const_t<decltype(view)>>);
+		CHECK(&view.front() == &g.connections_view("goodbye").front());
+		g.insert_node("lol");
+		CHECK(g.connections_view("lol").empty());
+		CHECK_THROWS_WITH(g.connections_view("hey"),
+		                  "Cannot call gdwg::graph<N, E>::connections_view if src doesn't exist in "
+		                  "the graph");
+	}
+}
+
+TEST_CASE("In connections") {
+	auto const list = std::initializer_list<std::string>{"hello", "goodbye", "hi"};
+	auto g = gdwg::graph<std::string, int>{list};
+	g.insert_edge("hello", "goodbye", 2);
+	g.insert_edge("hello", "goodbye", 3);
+	g.insert_edge("goodbye", "hello", 8);
+	g.insert_edge("hello", "hi", 4);
+	g.insert_edge("goodbye", "goodbye", 5);
+
+	SECTION("in_connections") {
+		CHECK(g.in_connections("goodbye") == std::vector<std::string>{"goodbye", "hello"});
+		CHECK(g.in_connections("hello") == std::vector<std::string>{"goodbye"});
+		CHECK(g.in_connections("hi") == std::vector<std::string>{"hello"});
+		g.insert_node("lol");
+		CHECK(g.in_connections("lol").empty());
+		CHECK_THROWS_WITH(g.in_connections("hey"),
+		                  "Cannot call gdwg::graph<N, E>::in_connections if dst doesn't exist in the "
+		                  "graph");
+	}
+	SECTION("in_edges") {
+		auto const edges = g.in_edges("goodbye");
+		REQUIRE(edges.size() == 3);
+		CHECK((edges[0].from == "goodbye" && edges[0].to == "goodbye" && edges[0].weight == 5));
+		CHECK((edges[1].from == "hello" && edges[1].to == "goodbye" && edges[1].weight == 2));
+		CHECK((edges[2].from == "hello" && edges[2].to == "goodbye" && edges[2].weight == 3));
+		CHECK(&edges[2].weight == &(*g.find("hello", "goodbye", 3)).weight);
+		CHECK_THROWS_WITH(g.in_edges("hey"),
+		                  "Cannot call gdwg::graph<N, E>::in_edges if dst doesn't exist in the "
+		                  "graph");
+	}
+	SECTION("Follows erased edges") {
+		g.erase_edge("hello", "goodbye", 2);
+		CHECK(g.in_connections("goodbye") == std::vector<std::string>{"goodbye", "hello"});
+		g.erase_edge(g.find("hello", "goodbye", 3));
+		CHECK(g.in_connections("goodbye") == std::vector<std::string>{"goodbye"});
+		g.erase_edge(g.begin(), g.end());
+		CHECK(g.in_connections("goodbye").empty());
+		CHECK(g.in_connections("hi").empty());
+	}
+	SECTION("Follows erased and replaced nodes") {
+		g.erase_node("goodbye");
+		CHECK(g.in_connections("hello").empty());
+		CHECK(g.in_connections("hi") == std::vector<std::string>{"hello"});
+		CHECK(g.replace_node("hello", "a"));
+		CHECK(g.in_connections("hi") == std::vector<std::string>{"a"});
+		CHECK(g.in_edges("hi").front().from == "a");
+	}
 }
 
 TEST_CASE("Iterator accessors - begin, end") {
@@ -596,6 +1168,22 @@ TEST_CASE("ITERATOR OPERATOR*") {
 	CHECK((*it).from == "a");
 	CHECK((*it).to == "a");
 	CHECK((*it).weight == 1);
+
+	SECTION("Refers to the stored values") {
+		auto const& [from, to, weight] = *std::next(it, 2);
+		CHECK(&from == &(*it).from);
+		CHECK(&to == &(*g.find("a", "b", 2)).to);
+		CHECK(weight == 2);
+		CHECK(&weight == &(*std::next(it, 2)).weight);
+	}
+	SECTION("Converts to value_type") {
+		gdwg::graph<std::string, int>::value_type const edge = *it;
+		g.replace_node("a", "z");
+		CHECK((edge.from == "a" && edge.to == "a" && edge.weight == 1));
+		auto const edges = std::vector<gdwg::graph<std::string, int>::value_type>(g.begin(), g.end());
+		CHECK(edges.size() == 3);
+		CHECK((edges.back().from == "z" && edges.back().to == "z" && edges.back().weight == 3));
+	}
 }
 
 TEST_CASE("ITERATOR OPERATOR ==") {
@@ -626,6 +1214,13 @@ TEST_CASE("ITERATOR OPERATOR ==") {
 		auto const g3 = gdwg::graph<std::string, int>{};
 		auto g4 = gdwg::graph<std::string, int>{};
 		CHECK(g3.begin() != g4.begin());
+		CHECK(g3.begin() == g3.end());
+	}
+	SECTION("Iterators compare by position") {
+		CHECK(g.find("a", "a", 3) == std::next(g.begin()));
+		CHECK(g.find("a", "b", 2) == std::prev(g.end()));
+		CHECK(g.find("a", "b", 3) == g.end());
+		CHECK(g.find("a", "z", 2) == g.end());
 	}
 }
 
@@ -681,4 +1276,216 @@ e (
 		auto const expected_output = std::string_view(R"()");
 		CHECK(out.str() == expected_output);
 	}
+
+	SECTION("Numbers print as operator<< prints them, whatever the stream's formatting") {
+		// What printing each piece with operator<< gives, on a stream set up by configure
+		auto const reference = [](auto const& graph, auto const& configure) {
+			auto out = std::ostringstream{};
+			configure(out);
+			for (auto const& node : graph.nodes()) {
+				out << node << " (\n";
+				for (auto const& e : graph) {
+					if (e.from == node) {
+						out << "  " << e.to << " | " << e.weight << "\n";
+					}
+				}
+				out << ")\n";
+			}
+			return out.str();
+		};
+		auto const printed = [](auto const& graph, auto const& configure) {
+			auto out = std::ostringstream{};
+			configure(out);
+			out << graph;
+			return out.str();
+		};
+		auto numbers = gdwg::graph<long, double>{-12, 0, 7, 1'000'000'007};
+		numbers.insert_edge(-12, 0, 0.1);
+		numbers.insert_edge(-12, 7, -1e-300);
+		numbers.insert_edge(7, 7, 123456789.0);
+		numbers.insert_edge(1'000'000'007, -12, 1.0 / 3);
+		numbers.insert_edge(0, 7, -0.0);
+		auto characters = gdwg::graph<char, unsigned char>{'x', 'y'};
+		characters.insert_edge('x', 'y', 'z');
+
+		auto const configurations = std::vector<std::function<void(std::ostream&)>>{
+		   [](std::ostream&) {},
+		   [](std::ostream& out) { out.precision(17); },
+		   [](std::ostream& out) { out.precision(0); },
+		   [](std::ostream& out) { out << std::hex << std::showpos; },
+		   [](std::ostream& out) { out << std::fixed; },
+		   [](std::ostream& out) { out.width(8); },
+		};
+		for (auto const& configure : configurations) {
+			CHECK(printed(numbers, configure) == reference(numbers, configure));
+			CHECK(printed(characters, configure) == reference(characters, configure));
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("Random operations match a reference model",
+                   "",
+                   int,
+                   std::string,
+                   ordered_weight,
+                   interned_weight) {
+	// Exercises node id reuse, the hashed node index and each kind of weight storage together by
+	// checking the graph against plain std::set bookkeeping.
+	using W = TestType;
+	auto g = gdwg::graph<int, W>{};
+	auto nodes = std::set<int>{};
+	auto edges = std::set<std::tuple<int, int, W>>{};
+	auto engine = std::mt19937{6771};
+	auto value = std::uniform_int_distribution<int>(0, 40);
+	auto weight = std::uniform_int_distribution<int>(0, 5);
+	auto op = std::uniform_int_distribution<int>(0, 10);
+	// Copies taken along the way, with the state they must keep however g changes afterwards
+	auto snapshots = std::vector<std::tuple<gdwg::graph<int, W>, std::set<int>, decltype(edges)>>{};
+
+	for (auto step = 0; step < 4000; ++step) {
+		if (step % 500 == 0) {
+			snapshots.emplace_back(g, nodes, edges);
+		}
+		auto const a = value(engine);
+		auto const b = value(engine);
+		auto const w = make_weight<W>(weight(engine));
+		switch (op(engine)) {
+		case 0:
+		case 1: CHECK(g.insert_node(a) == nodes.insert(a).second); break;
+		case 2:
+			if (step % 5 == 0) {
+				auto const erased = std::vector<int>{a, b, a};
+				auto const count = nodes.erase(a) + nodes.erase(b);
+				CHECK(g.erase_nodes(erased.begin(), erased.end()) == count);
+			}
+			else {
+				CHECK(g.erase_node(a) == (nodes.erase(a) == 1));
+			}
+			std::erase_if(edges, [&](auto const& e) {
+				return !nodes.contains(std::get<0>(e)) || !nodes.contains(std::get<1>(e));
+			});
+			break;
+		case 3:
+			if (nodes.contains(a) && !nodes.contains(b)) {
+				CHECK(g.replace_node(a, b));
+				nodes.erase(a);
+				nodes.insert(b);
+				auto renamed = std::set<std::tuple<int, int, W>>{};
+				for (auto [from, to, wt] : edges) {
+					renamed.emplace(from == a ? b : from, to == a ? b : to, wt);
+				}
+				edges = renamed;
+			}
+			break;
+		case 4:
+			if (step % 11 == 0) {
+				auto const erased = std::erase_if(edges, [&](auto const& e) {
+					return std::get<2>(e) == w && (std::get<0>(e) + std::get<1>(e)) % 3 == 0;
+				});
+				CHECK(g.erase_edges_if([&](auto const& e) {
+					return e.weight == w && (e.from + e.to) % 3 == 0;
+				}) == erased);
+			}
+			else if (step % 11 == 1 && nodes.contains(a)) {
+				auto const erased =
+				   std::erase_if(edges, [a](auto const& e) { return std::get<0>(e) == a; });
+				CHECK(g.erase_edges(a) == erased);
+			}
+			else if (nodes.contains(a) && nodes.contains(b)) {
+				CHECK(g.erase_edge(a, b, w) == (edges.erase({a, b, w}) == 1));
+			}
+			break;
+		case 5:
+			if (step % 7 == 0) {
+				// A batch of changes among existing nodes, committed at once
+				auto batch = g.batch();
+				auto const present = std::vector<int>(nodes.begin(), nodes.end());
+				auto pick = std::uniform_int_distribution<std::size_t>(0, present.size() - 1);
+				for (auto i = 0; !present.empty() && i < 20; ++i) {
+					auto const from = present[pick(engine)];
+					auto const to = present[pick(engine)];
+					auto const wt = make_weight<W>(weight(engine));
+					if (i % 3 == 0) {
+						batch.erase_edge(from, to, wt);
+						edges.erase({from, to, wt});
+					}
+					else {
+						batch.insert_edge(from, to, wt);
+						edges.emplace(from, to, wt);
+					}
+				}
+				batch.commit();
+			}
+			else if (a != b && nodes.contains(a) && nodes.contains(b)) {
+				g.merge_replace_node(a, b);
+				nodes.erase(a);
+				auto merged = std::set<std::tuple<int, int, W>>{};
+				for (auto [from, to, wt] : edges) {
+					merged.emplace(from == a ? b : from, to == a ? b : to, wt);
+				}
+				edges = merged;
+			}
+			break;
+		default:
+			if (nodes.contains(a) && nodes.contains(b)) {
+				CHECK(g.insert_edge(a, b, w) == edges.emplace(a, b, w).second);
+			}
+			break;
+		}
+	}
+
+	CHECK(g.nodes() == std::vector<int>(nodes.begin(), nodes.end()));
+	auto actual = std::set<std::tuple<int, int, W>>{};
+	auto previous = std::optional<std::tuple<int, int, W>>{};
+	for (auto const& [from, to, w] : g) {
+		auto const current = std::tuple{from, to, w};
+		CHECK((!previous || *previous < current));
+		previous = current;
+		actual.insert(current);
+	}
+	CHECK(actual == edges);
+	for (auto const n : nodes) {
+		CHECK(g.is_node(n));
+		auto connections = std::set<int>{};
+		for (auto const& [from, to, w] : edges) {
+			if (from == n) {
+				connections.insert(to);
+			}
+		}
+		CHECK(g.connections(n) == std::vector<int>(connections.begin(), connections.end()));
+		CHECK(std::ranges::equal(g.connections_view(n), connections));
+
+		auto in_connections = std::set<int>{};
+		auto in_edges = std::vector<std::tuple<int, int, W>>{};
+		for (auto const& [from, to, w] : edges) {
+			if (to == n) {
+				in_connections.insert(from);
+				in_edges.emplace_back(from, to, w);
+			}
+		}
+		CHECK(g.in_connections(n) == std::vector<int>(in_connections.begin(), in_connections.end()));
+		auto const actual_in_edges = g.in_edges(n);
+		CHECK(std::equal(actual_in_edges.begin(),
+		                 actual_in_edges.end(),
+		                 in_edges.begin(),
+		                 in_edges.end(),
+		                 [](auto const& e, auto const& expected) {
+			                 return std::tuple{e.from, e.to, e.weight} == expected;
+		                 }));
+	}
+	auto reversed = std::vector<std::tuple<int, int, W>>{};
+	for (auto it = g.end(); it != g.begin();) {
+		--it;
+		reversed.emplace_back((*it).from, (*it).to, (*it).weight);
+	}
+	CHECK(std::equal(reversed.rbegin(), reversed.rend(), actual.begin(), actual.end()));
+
+	for (auto const& [snapshot, snapshot_nodes, snapshot_edges] : snapshots) {
+		CHECK(snapshot.nodes() == std::vector<int>(snapshot_nodes.begin(), snapshot_nodes.end()));
+		auto snapshot_actual = std::set<std::tuple<int, int, W>>{};
+		for (auto const& [from, to, w] : snapshot) {
+			snapshot_actual.emplace(from, to, w);
+		}
+		CHECK(snapshot_actual == snapshot_edges);
+	}
 }
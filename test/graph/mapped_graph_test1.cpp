@@ -0,0 +1,137 @@
+#include "gdwg/mapped_graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	auto make_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"hello", "goodbye", "hi", "lonely"};
+		g.insert_edge("hello", "goodbye", 2);
+		g.insert_edge("hello", "goodbye", 3);
+		g.insert_edge("goodbye", "hello", 8);
+		g.insert_edge("hello", "hi", 4);
+		g.insert_edge("goodbye", "goodbye", 5);
+		g.insert_edge("hi", "hi", 1);
+		return g;
+	}
+
+	// A file in the temporary directory, removed when the test is done with it
+	struct temporary_file {
+		explicit temporary_file(std::string const& name)
+		: path{std::filesystem::temp_directory_path() / ("gdwg_mapped_graph_test_" + name)} {}
+		temporary_file(temporary_file const&) = delete;
+		auto operator=(temporary_file const&) -> temporary_file& = delete;
+		~temporary_file() {
+			std::filesystem::remove(path);
+		}
+
+		std::filesystem::path path;
+	};
+} // namespace
+
+TEST_CASE("Mapped graph") {
+	auto const g = make_graph();
+	auto const file = temporary_file("strings");
+	gdwg::save(g, file.path);
+	auto const m = gdwg::mapped_graph<std::string, int>(file.path);
+
+	SECTION("Answers queries like the graph it was saved from") {
+		CHECK(!m.empty());
+		CHECK(m.nodes() == g.nodes());
+		CHECK(m.is_node("lonely"));
+		CHECK(!m.is_node("missing"));
+		for (auto const& src : g.nodes()) {
+			CHECK(m.connections(src) == g.connections(src));
+			for (auto const& dst : g.nodes()) {
+				CHECK(m.is_connected(src, dst) == g.is_connected(src, dst));
+				CHECK(m.weights(src, dst) == g.weights(src, dst));
+			}
+		}
+	}
+
+	SECTION("Throws like graph on missing nodes") {
+		CHECK_THROWS_AS(m.is_connected("missing", "hello"), std::runtime_error);
+		CHECK_THROWS_AS(m.weights("hello", "missing"), std::runtime_error);
+		CHECK_THROWS_AS(m.connections("missing"), std::runtime_error);
+	}
+
+	SECTION("Thaws and loads back into an equal graph") {
+		CHECK(m.thaw() == g);
+		CHECK(gdwg::load<std::string, int>(file.path) == g);
+	}
+}
+
+TEST_CASE("Mapped graph value types") {
+	SECTION("Trivially copyable nodes and string weights") {
+		auto g = gdwg::graph<int, std::string>{1, 2, 3};
+		g.insert_edge(1, 2, "a much longer weight than fits in a small string");
+		g.insert_edge(1, 2, "");
+		g.insert_edge(3, 3, "loop");
+		auto const file = temporary_file("ints");
+		gdwg::save(g, file.path);
+		auto const m = gdwg::mapped_graph<int, std::string>(file.path);
+		CHECK(m.weights(1, 2) == g.weights(1, 2));
+		CHECK(m.connections(3) == std::vector<int>{3});
+		CHECK(m.thaw() == g);
+	}
+
+	SECTION("An empty graph") {
+		auto const file = temporary_file("empty");
+		gdwg::save(gdwg::graph<double, double>{}, file.path);
+		auto const m = gdwg::mapped_graph<double, double>(file.path);
+		CHECK(m.empty());
+		CHECK(m.thaw().empty());
+	}
+}
+
+TEST_CASE("Mapped graph rejects files it cannot read") {
+	auto const file = temporary_file("invalid");
+
+	SECTION("A missing file") {
+		CHECK_THROWS_AS((gdwg::mapped_graph<std::string, int>(file.path)), std::runtime_error);
+	}
+
+	SECTION("A file that is not a graph") {
+		std::ofstream(file.path) << "not a graph, but long enough to hold a whole header if it were";
+		CHECK_THROWS_AS((gdwg::mapped_graph<std::string, int>(file.path)), std::runtime_error);
+	}
+
+	SECTION("A graph of another type") {
+		gdwg::save(make_graph(), file.path);
+		CHECK_THROWS_AS((gdwg::mapped_graph<std::string, long>(file.path)), std::runtime_error);
+		CHECK_THROWS_AS((gdwg::mapped_graph<int, int>(file.path)), std::runtime_error);
+	}
+
+	SECTION("A truncated file") {
+		gdwg::save(make_graph(), file.path);
+		std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 4);
+		CHECK_THROWS_AS((gdwg::mapped_graph<std::string, int>(file.path)), std::runtime_error);
+	}
+
+	SECTION("A header whose counts overflow the section sizes") {
+		gdwg::save(make_graph(), file.path);
+		auto header = gdwg::detail::file_header{};
+		auto io = std::fstream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+		io.read(reinterpret_cast<char*>(&header), sizeof(header));
+		// edge_count * 4 wraps around to 0
+		header.edge_count = std::uint64_t{1} << 62U;
+		io.seekp(0);
+		io.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		io.close();
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, int>(file.path)),
+		                  "Cannot call gdwg::mapped_graph on a graph file that is truncated");
+
+		header.edge_count = 0;
+		header.weights = std::uint64_t{1} << 63U;
+		io.open(file.path, std::ios::in | std::ios::out | std::ios::binary);
+		io.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		io.close();
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, int>(file.path)),
+		                  "Cannot call gdwg::mapped_graph on a graph file that is truncated");
+	}
+}